@@ -12,8 +12,10 @@
 #include <boost/locale/conversion.hpp>
 #include <boost/locale/date_time.hpp>
 #include <boost/locale/date_time_facet.hpp>
+#include <boost/locale/default_locale.hpp>
 #include <boost/locale/encoding.hpp>
 #include <boost/locale/format.hpp>
+#include <boost/locale/format_values.hpp>
 #include <boost/locale/formatting.hpp>
 #include <boost/locale/generator.hpp>
 #include <boost/locale/gnu_gettext.hpp>
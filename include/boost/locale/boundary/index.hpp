@@ -11,6 +11,7 @@
 #include <boost/locale/boundary/facets.hpp>
 #include <boost/locale/boundary/segment.hpp>
 #include <boost/locale/boundary/types.hpp>
+#include <boost/locale/default_locale.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <algorithm>
 #include <cstdint>
@@ -515,7 +516,7 @@ namespace boost { namespace locale { namespace boundary {
                       base_iterator begin,
                       base_iterator end,
                       rule_type mask,
-                      const std::locale& loc = std::locale()) :
+                      const std::locale& loc = default_locale()) :
             map_(type, begin, end, loc),
             mask_(mask), full_select_(false)
         {}
@@ -524,7 +525,7 @@ namespace boost { namespace locale { namespace boundary {
         segment_index(boundary_type type,
                       base_iterator begin,
                       base_iterator end,
-                      const std::locale& loc = std::locale()) :
+                      const std::locale& loc = default_locale()) :
             map_(type, begin, end, loc),
             mask_(0xFFFFFFFFu), full_select_(false)
         {}
@@ -553,7 +554,7 @@ namespace boost { namespace locale { namespace boundary {
         /// in range [begin,end) for locale \a loc.
         ///
         /// \note \ref rule() and \ref full_select() remain unchanged.
-        void map(boundary_type type, base_iterator begin, base_iterator end, const std::locale& loc = std::locale())
+        void map(boundary_type type, base_iterator begin, base_iterator end, const std::locale& loc = default_locale())
         {
             map_ = mapping_type(type, begin, end, loc);
         }
@@ -739,7 +740,7 @@ namespace boost { namespace locale { namespace boundary {
                              base_iterator begin,
                              base_iterator end,
                              rule_type mask,
-                             const std::locale& loc = std::locale()) :
+                             const std::locale& loc = default_locale()) :
             map_(type, begin, end, loc),
             mask_(mask)
         {}
@@ -748,7 +749,7 @@ namespace boost { namespace locale { namespace boundary {
         boundary_point_index(boundary_type type,
                              base_iterator begin,
                              base_iterator end,
-                             const std::locale& loc = std::locale()) :
+                             const std::locale& loc = default_locale()) :
             map_(type, begin, end, loc),
             mask_(0xFFFFFFFFu)
         {}
@@ -776,7 +777,7 @@ namespace boost { namespace locale { namespace boundary {
         /// in range [begin,end) for locale \a loc.
         ///
         /// \note \ref rule() remains unchanged.
-        void map(boundary_type type, base_iterator begin, base_iterator end, const std::locale& loc = std::locale())
+        void map(boundary_type type, base_iterator begin, base_iterator end, const std::locale& loc = default_locale())
         {
             map_ = mapping_type(type, begin, end, loc);
         }
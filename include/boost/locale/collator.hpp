@@ -8,6 +8,8 @@
 #define BOOST_LOCALE_COLLATOR_HPP_INCLUDED
 
 #include <boost/locale/config.hpp>
+#include <boost/locale/default_locale.hpp>
+#include <atomic>
 #include <locale>
 
 #ifdef BOOST_MSVC
@@ -156,6 +158,35 @@ namespace boost { namespace locale {
         virtual long do_hash(collate_level level, const char_type* b, const char_type* e) const = 0;
     };
 
+    /// \brief A reference to the \ref collator facet of a locale which is looked up only once
+    ///
+    /// Use it instead of the locale when comparing many strings, e.g. for sorting,
+    /// to avoid the cost of \c std::use_facet for each comparison.
+    /// The locale is kept alive by the handle.
+    template<typename CharType>
+    class collator_handle {
+    public:
+        /// Create a handle for the collator of locale \a l
+        ///
+        /// \throws std::bad_cast: \a l does not have \ref collator facet installed
+        explicit collator_handle(const std::locale& l = default_locale()) :
+            locale_(l), facet_(&std::use_facet<collator<CharType>>(locale_))
+        {}
+
+        /// Get the locale the collator belongs to
+        const std::locale& getloc() const { return locale_; }
+        /// Get the collator facet
+        const collator<CharType>& get() const { return *facet_; }
+        /// Get the collator facet
+        const collator<CharType>& operator*() const { return *facet_; }
+        /// Access the collator facet
+        const collator<CharType>* operator->() const { return facet_; }
+
+    private:
+        std::locale locale_;
+        const collator<CharType>* facet_;
+    };
+
     /// \brief This class can be used in STL algorithms and containers for comparison of strings
     /// with a level other than primary
     ///
@@ -171,19 +202,48 @@ namespace boost { namespace locale {
     public:
         /// Create a comparator class for locale \a l and with collation leval \a level
         ///
-        /// \throws std::bad_cast: \a l does not have \ref collator facet installed
-        comparator(const std::locale& l = std::locale(), collate_level level = default_level) :
-            locale_(l), level_(level)
+        /// The \ref collator facet is looked up on the first comparison,
+        /// which throws std::bad_cast if \a l does not have it installed
+        comparator(const std::locale& l = default_locale(), collate_level level = default_level) :
+            locale_(l), collator_(nullptr), level_(level)
+        {}
+
+        /// Create a comparator class using the collator \a c and with collation leval \a level
+        comparator(const collator_handle<CharType>& c, collate_level level = default_level) :
+            locale_(c.getloc()), collator_(&c.get()), level_(level)
         {}
 
+        comparator(const comparator& other) :
+            locale_(other.locale_), collator_(other.collator_.load(std::memory_order_relaxed)), level_(other.level_)
+        {}
+        comparator& operator=(const comparator& other)
+        {
+            locale_ = other.locale_;
+            collator_.store(other.collator_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            level_ = other.level_;
+            return *this;
+        }
+
         /// Compare two strings -- equivalent to return left < right according to collation rules
         bool operator()(const std::basic_string<CharType>& left, const std::basic_string<CharType>& right) const
         {
-            return std::use_facet<collator<CharType>>(locale_).compare(level_, left, right) < 0;
+            return get_collator().compare(level_, left, right) < 0;
         }
 
     private:
+        const collator<CharType>& get_collator() const
+        {
+            const collator<CharType>* c = collator_.load(std::memory_order_relaxed);
+            if(!c) {
+                // Concurrent lookups find the same facet which is owned by locale_
+                c = &std::use_facet<collator<CharType>>(locale_);
+                collator_.store(c, std::memory_order_relaxed);
+            }
+            return *c;
+        }
+
         std::locale locale_;
+        mutable std::atomic<const collator<CharType>*> collator_;
         collate_level level_;
     };
 
@@ -7,6 +7,7 @@
 #ifndef BOOST_LOCALE_CONVERTER_HPP_INCLUDED
 #define BOOST_LOCALE_CONVERTER_HPP_INCLUDED
 
+#include <boost/locale/default_locale.hpp>
 #include <boost/locale/detail/facet_id.hpp>
 #include <boost/locale/detail/is_supported_char.hpp>
 #include <boost/locale/util/string.hpp>
@@ -56,6 +57,35 @@ namespace boost { namespace locale {
         convert(conversion_type how, const Char* begin, const Char* end, int flags = 0) const = 0;
     };
 
+    /// \brief A reference to the \ref converter facet of a locale which is looked up only once
+    ///
+    /// Pass it instead of the locale to the conversion functions when converting many strings
+    /// to avoid the cost of \c std::use_facet for each call.
+    /// The locale is kept alive by the handle.
+    template<typename Char>
+    class converter_handle {
+    public:
+        /// Create a handle for the converter of locale \a l
+        ///
+        /// \throws std::bad_cast: \a l does not have \ref converter facet installed
+        explicit converter_handle(const std::locale& l = default_locale()) :
+            locale_(l), facet_(&std::use_facet<converter<Char>>(locale_))
+        {}
+
+        /// Get the locale the converter belongs to
+        const std::locale& getloc() const { return locale_; }
+        /// Get the converter facet
+        const converter<Char>& get() const { return *facet_; }
+        /// Get the converter facet
+        const converter<Char>& operator*() const { return *facet_; }
+        /// Access the converter facet
+        const converter<Char>* operator->() const { return facet_; }
+
+    private:
+        std::locale locale_;
+        const converter<Char>* facet_;
+    };
+
     /// The type that defined <a href="http://unicode.org/reports/tr15/#Norm_Forms">normalization form</a>
     enum norm_type {
         norm_nfd,                ///< Canonical decomposition
@@ -76,7 +106,7 @@ namespace boost { namespace locale {
     std::basic_string<CharType> normalize(const CharType* begin,
                                           const CharType* end,
                                           norm_type n = norm_default,
-                                          const std::locale& loc = std::locale())
+                                          const std::locale& loc = default_locale())
     {
         return std::use_facet<converter<CharType>>(loc).convert(converter_base::normalization, begin, end, n);
     }
@@ -91,7 +121,7 @@ namespace boost { namespace locale {
     template<typename CharType>
     std::basic_string<CharType> normalize(const std::basic_string<CharType>& str,
                                           norm_type n = norm_default,
-                                          const std::locale& loc = std::locale())
+                                          const std::locale& loc = default_locale())
     {
         return normalize(str.data(), str.data() + str.size(), n, loc);
     }
@@ -105,11 +135,37 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType>
-    normalize(const CharType* str, norm_type n = norm_default, const std::locale& loc = std::locale())
+    normalize(const CharType* str, norm_type n = norm_default, const std::locale& loc = default_locale())
     {
         return normalize(str, util::str_end(str), n, loc);
     }
 
+    /// Normalize Unicode string in range [begin,end) according to \ref norm_type "normalization form" \a n
+    /// using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    normalize(const CharType* begin, const CharType* end, norm_type n, const converter_handle<CharType>& conv)
+    {
+        return conv->convert(converter_base::normalization, begin, end, n);
+    }
+
+    /// Normalize Unicode string \a str according to \ref norm_type "normalization form" \a n
+    /// using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    normalize(const std::basic_string<CharType>& str, norm_type n, const converter_handle<CharType>& conv)
+    {
+        return normalize(str.data(), str.data() + str.size(), n, conv);
+    }
+
+    /// Normalize NULL terminated Unicode string \a str according to \ref norm_type "normalization form" \a n
+    /// using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> normalize(const CharType* str, norm_type n, const converter_handle<CharType>& conv)
+    {
+        return normalize(str, util::str_end(str), n, conv);
+    }
+
     ///////////////////////////////////////////////////
 
     /// Convert a string in range [begin,end) to upper case according to locale \a loc
@@ -117,7 +173,7 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType>
-    to_upper(const CharType* begin, const CharType* end, const std::locale& loc = std::locale())
+    to_upper(const CharType* begin, const CharType* end, const std::locale& loc = default_locale())
     {
         return std::use_facet<converter<CharType>>(loc).convert(converter_base::upper_case, begin, end);
     }
@@ -126,7 +182,8 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_upper(const std::basic_string<CharType>& str, const std::locale& loc = std::locale())
+    std::basic_string<CharType>
+    to_upper(const std::basic_string<CharType>& str, const std::locale& loc = default_locale())
     {
         return to_upper(str.data(), str.data() + str.size(), loc);
     }
@@ -135,11 +192,33 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_upper(const CharType* str, const std::locale& loc = std::locale())
+    std::basic_string<CharType> to_upper(const CharType* str, const std::locale& loc = default_locale())
     {
         return to_upper(str, util::str_end(str), loc);
     }
 
+    /// Convert a string in range [begin,end) to upper case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    to_upper(const CharType* begin, const CharType* end, const converter_handle<CharType>& conv)
+    {
+        return conv->convert(converter_base::upper_case, begin, end);
+    }
+
+    /// Convert a string \a str to upper case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_upper(const std::basic_string<CharType>& str, const converter_handle<CharType>& conv)
+    {
+        return to_upper(str.data(), str.data() + str.size(), conv);
+    }
+
+    /// Convert a NULL terminated string \a str to upper case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_upper(const CharType* str, const converter_handle<CharType>& conv)
+    {
+        return to_upper(str, util::str_end(str), conv);
+    }
+
     ///////////////////////////////////////////////////
 
     /// Convert a string in range [begin,end) to lower case according to locale \a loc
@@ -147,7 +226,7 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType>
-    to_lower(const CharType* begin, const CharType* end, const std::locale& loc = std::locale())
+    to_lower(const CharType* begin, const CharType* end, const std::locale& loc = default_locale())
     {
         return std::use_facet<converter<CharType>>(loc).convert(converter_base::lower_case, begin, end);
     }
@@ -156,7 +235,8 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_lower(const std::basic_string<CharType>& str, const std::locale& loc = std::locale())
+    std::basic_string<CharType>
+    to_lower(const std::basic_string<CharType>& str, const std::locale& loc = default_locale())
     {
         return to_lower(str.data(), str.data() + str.size(), loc);
     }
@@ -165,11 +245,33 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_lower(const CharType* str, const std::locale& loc = std::locale())
+    std::basic_string<CharType> to_lower(const CharType* str, const std::locale& loc = default_locale())
     {
         return to_lower(str, util::str_end(str), loc);
     }
 
+    /// Convert a string in range [begin,end) to lower case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    to_lower(const CharType* begin, const CharType* end, const converter_handle<CharType>& conv)
+    {
+        return conv->convert(converter_base::lower_case, begin, end);
+    }
+
+    /// Convert a string \a str to lower case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_lower(const std::basic_string<CharType>& str, const converter_handle<CharType>& conv)
+    {
+        return to_lower(str.data(), str.data() + str.size(), conv);
+    }
+
+    /// Convert a NULL terminated string \a str to lower case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_lower(const CharType* str, const converter_handle<CharType>& conv)
+    {
+        return to_lower(str, util::str_end(str), conv);
+    }
+
     ///////////////////////////////////////////////////
 
     /// Convert a string in range [begin,end) to title case according to locale \a loc
@@ -177,7 +279,7 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType>
-    to_title(const CharType* begin, const CharType* end, const std::locale& loc = std::locale())
+    to_title(const CharType* begin, const CharType* end, const std::locale& loc = default_locale())
     {
         return std::use_facet<converter<CharType>>(loc).convert(converter_base::title_case, begin, end);
     }
@@ -186,7 +288,8 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_title(const std::basic_string<CharType>& str, const std::locale& loc = std::locale())
+    std::basic_string<CharType>
+    to_title(const std::basic_string<CharType>& str, const std::locale& loc = default_locale())
     {
         return to_title(str.data(), str.data() + str.size(), loc);
     }
@@ -195,11 +298,33 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> to_title(const CharType* str, const std::locale& loc = std::locale())
+    std::basic_string<CharType> to_title(const CharType* str, const std::locale& loc = default_locale())
     {
         return to_title(str, util::str_end(str), loc);
     }
 
+    /// Convert a string in range [begin,end) to title case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    to_title(const CharType* begin, const CharType* end, const converter_handle<CharType>& conv)
+    {
+        return conv->convert(converter_base::title_case, begin, end);
+    }
+
+    /// Convert a string \a str to title case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_title(const std::basic_string<CharType>& str, const converter_handle<CharType>& conv)
+    {
+        return to_title(str.data(), str.data() + str.size(), conv);
+    }
+
+    /// Convert a NULL terminated string \a str to title case using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> to_title(const CharType* str, const converter_handle<CharType>& conv)
+    {
+        return to_title(str, util::str_end(str), conv);
+    }
+
     ///////////////////////////////////////////////////
 
     /// Fold case of a string in range [begin,end) according to locale \a loc
@@ -207,7 +332,7 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType>
-    fold_case(const CharType* begin, const CharType* end, const std::locale& loc = std::locale())
+    fold_case(const CharType* begin, const CharType* end, const std::locale& loc = default_locale())
     {
         return std::use_facet<converter<CharType>>(loc).convert(converter_base::case_folding, begin, end);
     }
@@ -217,7 +342,7 @@ namespace boost { namespace locale {
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
     std::basic_string<CharType> fold_case(const std::basic_string<CharType>& str,
-                                          const std::locale& loc = std::locale())
+                                          const std::locale& loc = default_locale())
     {
         return fold_case(str.data(), str.data() + str.size(), loc);
     }
@@ -226,11 +351,34 @@ namespace boost { namespace locale {
     ///
     /// \throws std::bad_cast: \a loc does not have \ref converter facet installed
     template<typename CharType>
-    std::basic_string<CharType> fold_case(const CharType* str, const std::locale& loc = std::locale())
+    std::basic_string<CharType> fold_case(const CharType* str, const std::locale& loc = default_locale())
     {
         return fold_case(str, util::str_end(str), loc);
     }
 
+    /// Fold case of a string in range [begin,end) using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType>
+    fold_case(const CharType* begin, const CharType* end, const converter_handle<CharType>& conv)
+    {
+        return conv->convert(converter_base::case_folding, begin, end);
+    }
+
+    /// Fold case of a string \a str using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> fold_case(const std::basic_string<CharType>& str,
+                                          const converter_handle<CharType>& conv)
+    {
+        return fold_case(str.data(), str.data() + str.size(), conv);
+    }
+
+    /// Fold case of a NULL terminated string \a str using the converter \a conv
+    template<typename CharType>
+    std::basic_string<CharType> fold_case(const CharType* str, const converter_handle<CharType>& conv)
+    {
+        return fold_case(str, util::str_end(str), conv);
+    }
+
     ///@}
 }} // namespace boost::locale
 
@@ -0,0 +1,43 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_DEFAULT_LOCALE_HPP_INCLUDED
+#define BOOST_LOCALE_DEFAULT_LOCALE_HPP_INCLUDED
+
+#include <boost/locale/config.hpp>
+#include <locale>
+
+namespace boost { namespace locale {
+
+    /// Get the global locale, used by default by all functions taking an optional locale.
+    ///
+    /// Unless the global locale was set by \ref default_locale(const std::locale&) this is the same as
+    /// `std::locale()`. Otherwise a per-thread snapshot is returned which is only updated when the
+    /// global locale is changed via \ref default_locale(const std::locale&). This avoids the synchronization
+    /// between threads required to create or copy a `std::locale`.
+    ///
+    /// The returned reference is owned by the calling thread. It refers to the current global locale until the
+    /// next call of this function in the same thread after the global locale was changed. Copy it to keep it.
+    BOOST_LOCALE_DECL const std::locale& default_locale();
+
+    /// Set the global locale to \a loc, i.e. call `std::locale::global(loc)`, and return the previous one.
+    ///
+    /// From then on \ref default_locale() returns \a loc without synchronization between threads.
+    /// Changes of the global locale not done with this function are not seen by \ref default_locale() anymore
+    /// until \ref untrack_default_locale() is called.
+    ///
+    /// This function is thread safe
+    BOOST_LOCALE_DECL std::locale default_locale(const std::locale& loc);
+
+    /// Undo the effect of \ref default_locale(const std::locale&) on \ref default_locale() which returns
+    /// `std::locale()` again. The global locale itself is not changed.
+    ///
+    /// This function is thread safe
+    BOOST_LOCALE_DECL void untrack_default_locale();
+
+}} // namespace boost::locale
+
+#endif
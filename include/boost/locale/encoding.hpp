@@ -29,6 +29,15 @@ namespace boost { namespace locale {
         ///
         /// @{
 
+        /// Id of UTF-8 as returned by \ref charset_id
+        constexpr int utf8_charset_id = 1;
+
+        /// Get the id of \a charset in a fixed table of charsets known to Boost.Locale
+        ///
+        /// All names of a charset, e.g. "UTF-8" and "utf8", have the same id which doesn't change while the
+        /// program runs. Returns 0 for charsets not in the table. Does not allocate.
+        BOOST_LOCALE_DECL int charset_id(const boost::string_view& charset);
+
         /// convert text in range [begin,end) encoded with \a charset to UTF according to policy \a how
         ///
         /// \throws invalid_charset_error: Character set is not supported
@@ -84,7 +93,11 @@ namespace boost { namespace locale {
         std::basic_string<CharType>
         to_utf(const char* begin, const char* end, const std::locale& loc, method_type how = default_method)
         {
-            return to_utf<CharType>(begin, end, std::use_facet<info>(loc).encoding(), how);
+            const info& inf = std::use_facet<info>(loc);
+            // Avoid getting the name of the encoding for the common case
+            if(inf.encoding_id() == utf8_charset_id)
+                return utf_to_utf<CharType>(begin, end, how);
+            return to_utf<CharType>(begin, end, inf.encoding(), how);
         }
 
         /// Convert \a text in locale encoding given by \a loc to UTF according to policy \a how
@@ -97,7 +110,7 @@ namespace boost { namespace locale {
         std::basic_string<CharType>
         to_utf(const std::string& text, const std::locale& loc, method_type how = default_method)
         {
-            return to_utf<CharType>(text, std::use_facet<info>(loc).encoding(), how);
+            return to_utf<CharType>(text.c_str(), text.c_str() + text.size(), loc, how);
         }
 
         /// Convert \a text in locale encoding given by \a loc to UTF according to policy \a how
@@ -109,7 +122,7 @@ namespace boost { namespace locale {
         template<typename CharType>
         std::basic_string<CharType> to_utf(const char* text, const std::locale& loc, method_type how = default_method)
         {
-            return to_utf<CharType>(text, std::use_facet<info>(loc).encoding(), how);
+            return to_utf<CharType>(text, util::str_end(text), loc, how);
         }
 
         /// convert \a text from UTF to text encoded with \a charset according to policy \a how
@@ -145,7 +158,10 @@ namespace boost { namespace locale {
         std::string
         from_utf(const CharType* begin, const CharType* end, const std::locale& loc, method_type how = default_method)
         {
-            return from_utf(begin, end, std::use_facet<info>(loc).encoding(), how);
+            const info& inf = std::use_facet<info>(loc);
+            if(inf.encoding_id() == utf8_charset_id)
+                return utf_to_utf<char>(begin, end, how);
+            return from_utf(begin, end, inf.encoding(), how);
         }
 
         /// Convert \a text from UTF to locale encoding given by \a loc according to policy \a how
@@ -158,7 +174,7 @@ namespace boost { namespace locale {
         std::string
         from_utf(const std::basic_string<CharType>& text, const std::locale& loc, method_type how = default_method)
         {
-            return from_utf(text, std::use_facet<info>(loc).encoding(), how);
+            return from_utf(text.c_str(), text.c_str() + text.size(), loc, how);
         }
 
         /// Convert \a text from UTF to locale encoding given by \a loc according to policy \a how
@@ -170,7 +186,7 @@ namespace boost { namespace locale {
         template<typename CharType>
         std::string from_utf(const CharType* text, const std::locale& loc, method_type how = default_method)
         {
-            return from_utf(text, std::use_facet<info>(loc).encoding(), how);
+            return from_utf(text, util::str_end(text), loc, how);
         }
 
         /// Convert a text in range [begin,end) to \a to_encoding from \a from_encoding according to
@@ -11,8 +11,11 @@
 #include <boost/locale/formatting.hpp>
 #include <boost/locale/hold_ptr.hpp>
 #include <boost/locale/message.hpp>
+#include <array>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
 #include <vector>
 
@@ -103,6 +106,198 @@ namespace boost { namespace locale {
             hold_ptr<data> d;
         };
 
+        /// Restores the stream state changed by a format_parser even in case of exceptions
+        class format_guard {
+        public:
+            format_guard(format_parser& fmt) : fmt_(fmt), restored_(false) {}
+            void restore()
+            {
+                if(restored_)
+                    return;
+                fmt_.restore();
+                restored_ = true;
+            }
+            ~format_guard()
+            {
+                // clang-format off
+                try { restore(); } catch(...) {}
+                // clang-format on
+            }
+
+        private:
+            format_parser& fmt_;
+            bool restored_;
+        };
+
+        /// A format string split into literal text and placeholders with their (unapplied) flags.
+        ///
+        /// It is immutable after construction, so a single instance can be written concurrently from many threads.
+        template<typename CharType>
+        class compiled_format {
+        public:
+            typedef std::basic_string<CharType> string_type;
+            typedef std::basic_ostream<CharType> stream_type;
+
+            explicit compiled_format(const CharType* format);
+            explicit compiled_format(const string_type& format) : compiled_format(format.c_str()) {}
+
+            /// Write the format to \a out. \a get_param(position) shall return the formattible for a position
+            template<typename ParamGetter>
+            void write(stream_type& out, const ParamGetter& get_param) const
+            {
+                for(const segment& seg : segments_) {
+                    if(!seg.text.empty()) {
+                        // A pending width only applies to the first character as if it was written on its own
+                        if(out.width() != 0) {
+                            out << seg.text[0];
+                            out.write(seg.text.data() + 1, static_cast<std::streamsize>(seg.text.size() - 1));
+                        } else
+                            out.write(seg.text.data(), static_cast<std::streamsize>(seg.text.size()));
+                    }
+                    if(!seg.is_placeholder)
+                        continue;
+                    format_parser fmt(out, static_cast<void*>(&out), &compiled_format::imbue_locale);
+                    format_guard guard(fmt);
+                    for(const flag& f : seg.flags) {
+                        if(f.use_svalue)
+                            fmt.set_one_flag(f.key, f.svalue);
+                        else
+                            fmt.set_flag_with_str(f.key, f.value);
+                    }
+                    if(seg.is_terminated)
+                        out << get_param(fmt.get_position());
+                }
+            }
+
+        private:
+            struct flag {
+                std::string key;
+                std::string svalue;
+                string_type value;
+                bool use_svalue;
+            };
+            /// Literal text optionally followed by a placeholder
+            struct segment {
+                string_type text;
+                std::vector<flag> flags;
+                bool is_placeholder = false;
+                bool is_terminated = false;
+            };
+
+            static void imbue_locale(void* ptr, const std::locale& l) { static_cast<stream_type*>(ptr)->imbue(l); }
+
+            std::vector<segment> segments_;
+        };
+
+        template<typename CharType>
+        compiled_format<CharType>::compiled_format(const CharType* format)
+        {
+            constexpr CharType obrk = '{';
+            constexpr CharType cbrk = '}';
+            constexpr CharType eq = '=';
+            constexpr CharType comma = ',';
+            constexpr CharType quote = '\'';
+
+            const size_t size = std::char_traits<CharType>::length(format);
+            segments_.emplace_back();
+            for(size_t pos = 0; format[pos];) {
+                if(format[pos] != obrk) {
+                    if(format[pos] == cbrk && format[pos + 1] == cbrk) {
+                        segments_.back().text += cbrk;
+                        pos += 2;
+                    } else {
+                        segments_.back().text += format[pos];
+                        pos++;
+                    }
+                    continue;
+                }
+                pos++;
+                if(format[pos] == obrk) {
+                    segments_.back().text += obrk;
+                    continue;
+                }
+
+                segment& placeholder = segments_.back();
+                placeholder.is_placeholder = true;
+
+                while(pos < size) {
+                    flag f;
+                    f.use_svalue = true;
+                    for(CharType c = format[pos]; !(c == 0 || c == comma || c == eq || c == cbrk); c = format[++pos])
+                        f.key += static_cast<char>(c);
+
+                    if(format[pos] == eq) {
+                        pos++;
+                        if(format[pos] == quote) {
+                            pos++;
+                            f.use_svalue = false;
+                            while(format[pos]) {
+                                if(format[pos] == quote) {
+                                    if(format[pos + 1] == quote) {
+                                        f.value += quote;
+                                        pos += 2;
+                                    } else {
+                                        pos++;
+                                        break;
+                                    }
+                                } else {
+                                    f.value += format[pos];
+                                    pos++;
+                                }
+                            }
+                        } else {
+                            CharType c;
+                            while((c = format[pos]) != 0 && c != comma && c != cbrk) {
+                                f.svalue += static_cast<char>(c);
+                                pos++;
+                            }
+                        }
+                    }
+                    // Empty keys are ignored by the format_parser
+                    if(!f.key.empty())
+                        placeholder.flags.push_back(std::move(f));
+
+                    if(format[pos] == comma)
+                        pos++;
+                    else {
+                        if(format[pos] == cbrk) {
+                            placeholder.is_terminated = true;
+                            pos++;
+                        }
+                        break;
+                    }
+                }
+                segments_.emplace_back();
+            }
+            if(segments_.back().text.empty())
+                segments_.pop_back();
+        }
+
+        /// Thread safe storage of objects created for a locale and message domain, e.g. translated formats.
+        ///
+        /// Only the max_size most recently used entries are kept.
+        /// Their locales are kept alive by the cache so their identity can't be reused while an entry exists.
+        class BOOST_LOCALE_DECL locale_cache {
+        public:
+            static constexpr size_t max_size = 16;
+
+            locale_cache();
+            ~locale_cache();
+            locale_cache(const locale_cache&) = delete;
+            locale_cache& operator=(const locale_cache&) = delete;
+
+            /// Return the object stored for \a loc and \a domain_id or an empty pointer
+            std::shared_ptr<const void> find(const std::locale& loc, int domain_id) const;
+            /// Store \a value for \a loc and \a domain_id unless an object is already stored for them.
+            /// Return the stored object.
+            std::shared_ptr<const void>
+            insert(const std::locale& loc, int domain_id, std::shared_ptr<const void> value) const;
+
+        private:
+            struct data;
+            hold_ptr<data> d;
+        };
+
     } // namespace detail
 
     /// \endcond
@@ -239,7 +434,7 @@ namespace boost { namespace locale {
         }
 
         /// Format a string using a locale \a loc
-        string_type str(const std::locale& loc = std::locale()) const
+        string_type str(const std::locale& loc = default_locale()) const
         {
             std::basic_ostringstream<CharType> buffer;
             buffer.imbue(loc);
@@ -250,38 +445,20 @@ namespace boost { namespace locale {
         /// write a formatted string to output stream \a out using out's locale
         void write(stream_type& out) const
         {
+            if(!translate_) {
+                format_output(out, format_);
+                return;
+            }
             string_type format;
-            if(translate_)
-                format = message_.str(out.getloc(), ios_info::get(out).domain_id());
+            const int domain_id = ios_info::get(out).domain_id();
+            if(const auto* compiled = message_.translate_format(out.getloc(), domain_id, format))
+                compiled->write(out, [this](unsigned id) { return get(id); });
             else
-                format = format_;
-
-            format_output(out, format);
+                format_output(out, format);
         }
 
     private:
-        class format_guard {
-        public:
-            format_guard(detail::format_parser& fmt) : fmt_(fmt), restored_(false) {}
-            void restore()
-            {
-                if(restored_)
-                    return;
-                fmt_.restore();
-                restored_ = true;
-            }
-            ~format_guard()
-            {
-                // clang-format off
-                try { restore(); } catch(...) {}
-                // clang-format on
-            }
-
-        private:
-            detail::format_parser& fmt_;
-            bool restored_;
-        };
-
+        /// Parse and write \a sformat in one pass which is faster than compiling it when used only once
         void format_output(stream_type& out, const string_type& sformat) const
         {
             constexpr char_type obrk = '{';
@@ -311,7 +488,7 @@ namespace boost { namespace locale {
 
                 detail::format_parser fmt(out, static_cast<void*>(&out), &basic_format::imbue_locale);
 
-                format_guard guard(fmt);
+                detail::format_guard guard(fmt);
 
                 while(pos < size) {
                     std::string key;
@@ -369,6 +546,8 @@ namespace boost { namespace locale {
             }
         }
 
+        static void imbue_locale(void* ptr, const std::locale& l) { static_cast<stream_type*>(ptr)->imbue(l); }
+
         void add(const formattible_type& param)
         {
             if(parameters_count_ >= base_params_)
@@ -388,8 +567,6 @@ namespace boost { namespace locale {
                 return parameters_[id];
         }
 
-        static void imbue_locale(void* ptr, const std::locale& l) { static_cast<stream_type*>(ptr)->imbue(l); }
-
         static constexpr unsigned base_params_ = 8;
 
         message_type message_;
@@ -433,6 +610,269 @@ namespace boost { namespace locale {
             throw std::invalid_argument("Can't move a basic_format with bound parameters");
         return 0;
     }
+
+    /// \brief A list of strings stored in one contiguous buffer, e.g. the result of
+    /// \ref basic_format_template::render_all or \ref format_values
+    template<typename CharType>
+    class basic_string_arena {
+    public:
+        typedef CharType char_type;                             ///< Underlying character type
+        typedef std::basic_string<CharType> string_type;        ///< string type for this type of character
+        typedef boost::basic_string_view<CharType> string_view; ///< Type referring to a single string
+
+        /// Create an empty arena
+        basic_string_arena() : offsets_(1, 0) {}
+        /// Create an arena from the concatenated strings in \a buffer where string \c i is
+        /// [offsets[i], offsets[i + 1]). \a offsets must contain at least one element
+        basic_string_arena(string_type buffer, std::vector<size_t> offsets) :
+            buffer_(std::move(buffer)), offsets_(std::move(offsets))
+        {}
+
+        /// Number of strings
+        size_t size() const { return offsets_.size() - 1; }
+        /// Check if there are no strings
+        bool empty() const { return size() == 0; }
+        /// Return the string at index \a i. The view is invalidated by adding more strings
+        string_view operator[](size_t i) const
+        {
+            return string_view(buffer_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+        }
+        /// Return a copy of the string at index \a i
+        string_type str(size_t i) const { return string_type(buffer_, offsets_[i], offsets_[i + 1] - offsets_[i]); }
+
+        /// The concatenation of all strings
+        const string_type& buffer() const { return buffer_; }
+        /// Start offset of each string in buffer() followed by the size of the buffer
+        const std::vector<size_t>& offsets() const { return offsets_; }
+
+        /// Reserve space for \a num_strings strings of \a string_size characters each
+        void reserve(size_t num_strings, size_t string_size)
+        {
+            offsets_.reserve(offsets_.size() + num_strings);
+            buffer_.reserve(buffer_.size() + num_strings * string_size);
+        }
+        /// Remove all strings
+        void clear()
+        {
+            buffer_.clear();
+            offsets_.assign(1, 0);
+        }
+
+        /// Append the values of the range [\a begin, \a end) formatted as they would be written to a stream
+        /// with the format of \a format, i.e. its locale, flags, precision, width, fill
+        /// and the Boost.Locale settings like as::number, as::ftime or as::time_zone.
+        ///
+        /// The stream is set up only once and the formatter used for the values is reused,
+        /// which makes this much faster than writing each value to a new stream.
+        /// The width of \a format applies to every value.
+        ///
+        /// Stops at the first value which fails to be written and returns the number of values appended.
+        /// The output of the failed value is removed. If writing a value throws, its output is removed as well
+        /// and the exception is propagated.
+        ///
+        /// To use multiple threads split the range and format each part into a separate object.
+        template<typename Iterator>
+        size_t append(const std::basic_ios<CharType>& format, Iterator begin, Iterator end)
+        {
+            appending_buf buf(buffer_);
+            std::basic_ostream<CharType> out(&buf);
+            out.copyfmt(format);
+            out.tie(nullptr);
+            const std::streamsize width = format.width();
+            size_t count = 0;
+            try {
+                for(; begin != end; ++begin) {
+                    out.width(width);
+                    out << *begin;
+                    if(!out)
+                        break;
+                    offsets_.push_back(buffer_.size());
+                    ++count;
+                }
+            } catch(...) {
+                buffer_.resize(offsets_.back());
+                throw;
+            }
+            buffer_.resize(offsets_.back());
+            return count;
+        }
+
+    private:
+        /// Stream buffer appending to a string
+        class appending_buf : public std::basic_streambuf<CharType> {
+        public:
+            typedef typename std::basic_streambuf<CharType>::int_type int_type;
+            typedef typename std::basic_streambuf<CharType>::traits_type traits_type;
+
+            explicit appending_buf(string_type& str) : str_(str) {}
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                if(!traits_type::eq_int_type(c, traits_type::eof()))
+                    str_ += traits_type::to_char_type(c);
+                return traits_type::not_eof(c);
+            }
+            std::streamsize xsputn(const CharType* s, std::streamsize n) override
+            {
+                str_.append(s, static_cast<size_t>(n));
+                return n;
+            }
+
+        private:
+            string_type& str_;
+        };
+
+        string_type buffer_;
+        std::vector<size_t> offsets_;
+    };
+
+    /// Definition of char based string arena
+    typedef basic_string_arena<char> string_arena;
+    /// Definition of wchar_t based string arena
+    typedef basic_string_arena<wchar_t> wstring_arena;
+
+    /// \brief An immutable format that can be rendered many times with different arguments
+    ///
+    /// Unlike \ref basic_format the arguments are passed on rendering instead of being bound to the object.
+    /// Hence a template can be stored, e.g. in a static variable, and be rendered concurrently from many threads:
+    /// \code
+    ///  static const format_template greeting(translate("Hello {1}, you are {2} years old"));
+    ///  std::cout << greeting.render(loc, name, age) << std::endl;
+    /// \endcode
+    ///
+    /// The format string is parsed only once. A translated message is looked up and parsed once per locale and
+    /// message domain it is rendered in. The results for the most recently used locales are cached,
+    /// those locales are referenced and kept alive by the template.
+    template<typename CharType>
+    class basic_format_template {
+    public:
+        typedef CharType char_type;                       ///< Underlying character type
+        typedef basic_message<char_type> message_type;    ///< The translation message type
+        typedef std::basic_string<CharType> string_type;  ///< string type for this type of character
+        typedef std::basic_ostream<CharType> stream_type; ///< output stream type for this type of character
+
+        /// Create a template for \a format_string
+        explicit basic_format_template(const string_type& format_string) :
+            format_(new detail::compiled_format<CharType>(format_string))
+        {}
+        /// Create a template using message \a trans. The message is translated according to the rules of the target
+        /// locale and then interpreted as a format string
+        explicit basic_format_template(const message_type& trans) : message_(trans) {}
+
+        /// Non-copyable
+        basic_format_template(const basic_format_template&) = delete;
+        void operator=(const basic_format_template&) = delete;
+
+        /// Format the arguments \a args into a string using locale \a loc and the default message domain
+        template<typename... Formattible>
+        string_type render(const std::locale& loc, const Formattible&... args) const
+        {
+            std::basic_ostringstream<CharType> buffer;
+            buffer.imbue(loc);
+            write(buffer, args...);
+            return buffer.str();
+        }
+
+        /// Write the formatted arguments \a args to stream \a out using its locale and message domain
+        template<typename... Formattible>
+        void write(stream_type& out, const Formattible&... args) const
+        {
+            const auto params = make_params(args...);
+            write_params(out, ios_info::get(out).domain_id(), params);
+        }
+
+        /// Format the arguments \a args for each locale in the range [\a first, \a last) using the default message
+        /// domain.
+        ///
+        /// The arguments are bound only once and all results are written into one buffer without creating
+        /// a stream for each locale.
+        ///
+        /// \throws std::ios_base::failure if writing any argument fails
+        template<typename LocaleIterator, typename... Formattible>
+        basic_string_arena<CharType>
+        render_all(LocaleIterator first, LocaleIterator last, const Formattible&... args) const
+        {
+            const auto params = make_params(args...);
+            std::basic_ostringstream<CharType> buffer;
+            std::vector<size_t> offsets(1, 0);
+            for(; first != last; ++first) {
+                const std::locale& loc = *first;
+                buffer.imbue(loc);
+                write_params(buffer, 0, params);
+                if(!buffer)
+                    throw std::ios_base::failure("Failed to write the formatted arguments");
+                offsets.push_back(static_cast<size_t>(buffer.tellp()));
+            }
+            return basic_string_arena<CharType>(buffer.str(), std::move(offsets));
+        }
+
+        /// Format the arguments \a args for each locale in \a locales, see render_all(first, last, args...)
+        template<typename... Formattible>
+        basic_string_arena<CharType> render_all(const std::vector<std::locale>& locales,
+                                                const Formattible&... args) const
+        {
+            return render_all(locales.begin(), locales.end(), args...);
+        }
+
+    private:
+        typedef detail::formattible<CharType> formattible_type;
+
+        template<typename... Formattible>
+        static std::array<formattible_type, sizeof...(Formattible)> make_params(const Formattible&... args)
+        {
+            return {{formattible_type(args)...}};
+        }
+
+        template<size_t N>
+        void write_params(stream_type& out, int domain_id, const std::array<formattible_type, N>& params) const
+        {
+            const auto get_param = [&params](unsigned id) {
+                return id < params.size() ? params[id] : formattible_type();
+            };
+            if(format_)
+                format_->write(out, get_param);
+            else {
+                // Keep the format alive while writing even if it is removed from the cache meanwhile
+                const std::shared_ptr<const void> compiled = get(out.getloc(), domain_id);
+                static_cast<const detail::compiled_format<CharType>*>(compiled.get())->write(out, get_param);
+            }
+        }
+
+        std::shared_ptr<const void> get(const std::locale& loc, int domain_id) const
+        {
+            std::shared_ptr<const void> compiled = cache_.find(loc, domain_id);
+            if(!compiled) {
+                string_type translation;
+                if(const auto* catalog_format = message_.translate_format(loc, domain_id, translation)) {
+                    // Owned by the message facet of the locale, so keep the locale alive with it
+                    compiled = std::shared_ptr<const void>(std::make_shared<std::locale>(loc), catalog_format);
+                } else
+                    compiled = std::make_shared<detail::compiled_format<CharType>>(translation);
+                compiled = cache_.insert(loc, domain_id, std::move(compiled));
+            }
+            return compiled;
+        }
+
+        std::unique_ptr<const detail::compiled_format<CharType>> format_;
+        message_type message_;
+        detail::locale_cache cache_;
+    };
+
+    /// Definition of char based format template
+    typedef basic_format_template<char> format_template;
+    /// Definition of wchar_t based format template
+    typedef basic_format_template<wchar_t> wformat_template;
+
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+    /// Definition of char16_t based format template
+    typedef basic_format_template<char16_t> u16format_template;
+#endif
+
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+    /// Definition of char32_t based format template
+    typedef basic_format_template<char32_t> u32format_template;
+#endif
     /// @}
 }} // namespace boost::locale
 
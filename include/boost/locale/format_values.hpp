@@ -0,0 +1,36 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_FORMAT_VALUES_HPP_INCLUDED
+#define BOOST_LOCALE_FORMAT_VALUES_HPP_INCLUDED
+
+#include <boost/locale/format.hpp>
+#include <ios>
+
+namespace boost { namespace locale {
+
+    /// Format the values of the range [\a begin, \a end) with the format of \a format into a single buffer.
+    ///
+    /// For example to format a column of timestamps:
+    /// \code
+    ///   std::ostringstream format;
+    ///   format.imbue(loc);
+    ///   format << as::ftime("%Y-%m-%d %H:%M:%S") << as::time_zone("Europe/Berlin");
+    ///   const string_arena result = format_values(format, times.begin(), times.end());
+    /// \endcode
+    ///
+    /// Formatting stops at the first value which fails to be written, see basic_string_arena::append.
+    template<typename CharType, typename Iterator>
+    basic_string_arena<CharType> format_values(const std::basic_ios<CharType>& format, Iterator begin, Iterator end)
+    {
+        basic_string_arena<CharType> result;
+        result.append(format, begin, end);
+        return result;
+    }
+
+}} // namespace boost::locale
+
+#endif
@@ -93,6 +93,8 @@ namespace locale {
     ///
     /// This class is used for specification of all parameters required for locale generation and
     /// caching. This class const member functions are thread safe if locale class implementation is thread safe.
+    ///
+    /// Locales returned from the cache are looked up without locking.
     class BOOST_LOCALE_DECL generator {
     public:
         /// Create new generator using global localization_backend_manager
@@ -164,6 +166,24 @@ namespace locale {
         /// Get locale cache option
         bool locale_cache_enabled() const;
 
+        /// Limit the number of cached locales to \a max_locales. When the limit is exceeded the least recently used
+        /// locales are removed from the cache. 0 (the default) means no limit.
+        void locale_cache_limit(size_t max_locales);
+
+        /// Get the maximal number of cached locales, 0 if unlimited
+        size_t locale_cache_limit() const;
+
+        /// Usage statistics of the locale cache
+        struct cache_statistics {
+            uint64_t hits;      ///< Number of locales returned from the cache
+            uint64_t misses;    ///< Number of locales generated while caching was enabled
+            uint64_t evictions; ///< Number of locales removed due to the cache limit
+            size_t size;        ///< Number of currently cached locales
+        };
+
+        /// Get the usage statistics of the locale cache
+        cache_statistics locale_cache_statistics() const;
+
         /// Check if by default ANSI encoding is selected or UTF-8 onces. The default is false.
         bool use_ansi_encoding() const;
 
@@ -174,6 +194,19 @@ namespace locale {
         /// can select "system" one if dealing with legacy applications
         void use_ansi_encoding(bool enc);
 
+        /// Check if facets are created on first use. The default is false.
+        bool lazy_facets() const;
+
+        /// Create facets which are expensive to construct, like collation, conversion and message catalogs,
+        /// only when they are used for the first time instead of during generation.
+        ///
+        /// This makes generation of locales cheaper when only some of their facets are used.
+        /// Currently only supported by the ICU backend, other backends ignore it.
+        ///
+        /// \note Errors creating those facets, e.g. invalid message catalogs, are then not thrown by generate()
+        /// but by each use of the facet, e.g. when translating a message.
+        void lazy_facets(bool lazy);
+
         /// Generate a locale with id \a id
         std::locale generate(const std::string& id) const;
         /// Generate a locale with id \a id. Use \a base as a locale to which all facets are added,
@@ -35,7 +35,8 @@ namespace boost { namespace locale {
 
         /// Integer information about locale
         enum integer_property {
-            utf8_property ///< Non zero value if uses UTF-8 encoding
+            utf8_property,       ///< Non zero value if uses UTF-8 encoding
+            encoding_id_property ///< Id of the encoding as returned by \ref conv::charset_id
         };
 
         /// Standard facet's constructor
@@ -55,6 +56,12 @@ namespace boost { namespace locale {
         /// True if the underlying encoding is UTF-8 (for char streams and strings)
         bool utf8() const { return get_integer_property(utf8_property) != 0; }
 
+        /// Get the id of the encoding in the table of charsets known to Boost.Locale, see \ref conv::charset_id
+        ///
+        /// Unlike \ref encoding() this does not allocate, so use it to compare the encodings of locales.
+        /// Returns 0 for an encoding not in the table or if this facet does not provide it.
+        int encoding_id() const { return get_integer_property(encoding_id_property); }
+
     protected:
         /// Get string property by its id \a v
         virtual std::string get_string_property(string_propery v) const = 0;
@@ -8,7 +8,6 @@
 #define BOOST_LOCALE_LOCALIZATION_BACKEND_HPP
 
 #include <boost/locale/generator.hpp>
-#include <boost/locale/hold_ptr.hpp>
 #include <locale>
 #include <memory>
 #include <string>
@@ -58,6 +57,12 @@ namespace boost { namespace locale {
         /// Create a facet for category \a category and character type \a type
         virtual std::locale install(const std::locale& base, category_t category, char_facet_t type) = 0;
 
+        /// Create the facets for all categories in \a categories and all character types in \a types
+        ///
+        /// The default implementation calls \ref install for each of them.
+        /// Backends can override it to share facets and work between categories.
+        virtual std::locale install_all(const std::locale& base, category_t categories, char_facet_t types);
+
     }; // localization_backend
 
     /// \brief Localization backend manager is a class that holds various backend and allows creation
@@ -66,7 +71,7 @@ namespace boost { namespace locale {
     public:
         /// New empty localization_backend_manager
         localization_backend_manager();
-        /// Copy localization_backend_manager
+        /// Copy localization_backend_manager, the registered backends are shared
         localization_backend_manager(const localization_backend_manager&);
         /// Assign localization_backend_manager
         localization_backend_manager& operator=(const localization_backend_manager&);
@@ -112,12 +117,17 @@ namespace boost { namespace locale {
         static localization_backend_manager global(const localization_backend_manager&);
         /// Get global backend manager
         ///
-        /// This function is thread safe
+        /// This function is thread safe.
+        /// The registered backends are shared, not copied, so this is cheap.
         static localization_backend_manager global();
 
     private:
         class impl;
-        hold_ptr<impl> pimpl_;
+        explicit localization_backend_manager(std::shared_ptr<const impl> pimpl);
+        /// Get a modifiable state not shared with any other manager
+        impl& modify();
+
+        std::shared_ptr<const impl> pimpl_;
     };
 
 }} // namespace boost::locale
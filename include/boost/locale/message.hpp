@@ -8,6 +8,7 @@
 #ifndef BOOST_LOCALE_MESSAGE_HPP_INCLUDED
 #define BOOST_LOCALE_MESSAGE_HPP_INCLUDED
 
+#include <boost/locale/default_locale.hpp>
 #include <boost/locale/detail/facet_id.hpp>
 #include <boost/locale/detail/is_supported_char.hpp>
 #include <boost/locale/formatting.hpp>
@@ -43,6 +44,13 @@ namespace boost { namespace locale {
     /// Type used for the count/n argument to the translation functions choosing between singular and plural forms
     using count_type = long long;
 
+    /// \cond INTERNAL
+    namespace detail {
+        template<typename CharType>
+        class compiled_format;
+    }
+    /// \endcond
+
     /// \brief This facet provides message formatting abilities
     template<typename CharType>
     class BOOST_SYMBOL_VISIBLE message_format : public std::locale::facet,
@@ -90,6 +98,17 @@ namespace boost { namespace locale {
         /// Note: for char_type that is char16_t, char32_t and wchar_t it is no-op, returns
         /// msg
         virtual const char_type* convert(const char_type* msg, string_type& buffer) const = 0;
+
+        /// \cond INTERNAL
+        /// Return the parsed format string of \a translation which must be a result of one of the \a get functions.
+        /// The result is valid as long as the facet exists.
+        ///
+        /// If NULL is returned (the default) the translation is parsed on each use.
+        virtual const detail::compiled_format<char_type>* get_format(const char_type* /*translation*/) const
+        {
+            return nullptr;
+        }
+        /// \endcond
     };
 
     /// \cond INTERNAL
@@ -235,7 +254,7 @@ namespace boost { namespace locale {
         operator string_type() const { return str(); }
 
         /// Translate message to a string in the default global locale, using default domain
-        string_type str() const { return str(std::locale()); }
+        string_type str() const { return str(default_locale()); }
 
         /// Translate message to a string in the locale \a locale, using default domain
         string_type str(const std::locale& locale) const { return str(locale, 0); }
@@ -250,7 +269,7 @@ namespace boost { namespace locale {
         }
 
         /// Translate message to a string using the default locale and message domain  \a domain_id
-        string_type str(const std::string& domain_id) const { return str(std::locale(), domain_id); }
+        string_type str(const std::string& domain_id) const { return str(default_locale(), domain_id); }
 
         /// Translate message to a string using locale \a loc and message domain index  \a id
         string_type str(const std::locale& loc, int id) const
@@ -272,6 +291,25 @@ namespace boost { namespace locale {
             out << write(loc, id, buffer);
         }
 
+        /// \cond INTERNAL
+        /// Translate the message using locale \a loc and message domain index \a domain_id.
+        /// If the message catalog provides the parsed format of the translation it is returned.
+        /// Otherwise NULL is returned and the translation is stored in \a buffer.
+        const detail::compiled_format<char_type>*
+        translate_format(const std::locale& loc, int domain_id, string_type& buffer) const
+        {
+            const facet_type* translated_by;
+            const char_type* ptr = write(loc, domain_id, buffer, translated_by);
+            if(translated_by) {
+                if(const auto* format = translated_by->get_format(ptr))
+                    return format;
+            }
+            if(ptr != buffer.c_str())
+                buffer = ptr;
+            return nullptr;
+        }
+        /// \endcond
+
     private:
         const char_type* plural() const
         {
@@ -293,9 +331,19 @@ namespace boost { namespace locale {
         const char_type* id() const { return c_id_ ? c_id_ : id_.c_str(); }
 
         const char_type* write(const std::locale& loc, int domain_id, string_type& buffer) const
+        {
+            const facet_type* translated_by;
+            return write(loc, domain_id, buffer, translated_by);
+        }
+
+        /// Translate the message. \a translated_by is set to the facet if it found a translation, else to NULL
+        const char_type*
+        write(const std::locale& loc, int domain_id, string_type& buffer, const facet_type*& translated_by) const
         {
             static const char_type empty_string[1] = {0};
 
+            translated_by = nullptr;
+
             const char_type* id = this->id();
             const char_type* context = this->context();
             const char_type* plural = this->plural();
@@ -313,6 +361,8 @@ namespace boost { namespace locale {
                     translated = facet->get(domain_id, context, id);
                 else
                     translated = facet->get(domain_id, context, id, n_);
+                if(translated)
+                    translated_by = facet;
             }
 
             if(!translated) {
@@ -429,21 +479,22 @@ namespace boost { namespace locale {
 
     /// Translate message \a id according to locale \a loc
     template<typename CharType>
-    std::basic_string<CharType> gettext(const CharType* id, const std::locale& loc = std::locale())
+    std::basic_string<CharType> gettext(const CharType* id, const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(id).str(loc);
     }
     /// Translate plural form according to locale \a loc
     template<typename CharType>
     std::basic_string<CharType>
-    ngettext(const CharType* s, const CharType* p, count_type n, const std::locale& loc = std::locale())
+    ngettext(const CharType* s, const CharType* p, count_type n, const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(s, p, n).str(loc);
     }
 
     /// Translate message \a id according to locale \a loc in domain \a domain
     template<typename CharType>
-    std::basic_string<CharType> dgettext(const char* domain, const CharType* id, const std::locale& loc = std::locale())
+    std::basic_string<CharType>
+    dgettext(const char* domain, const CharType* id, const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(id).str(loc, domain);
     }
@@ -454,7 +505,7 @@ namespace boost { namespace locale {
                                           const CharType* s,
                                           const CharType* p,
                                           count_type n,
-                                          const std::locale& loc = std::locale())
+                                          const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(s, p, n).str(loc, domain);
     }
@@ -462,7 +513,7 @@ namespace boost { namespace locale {
     /// Translate message \a id according to locale \a loc in context \a context
     template<typename CharType>
     std::basic_string<CharType>
-    pgettext(const CharType* context, const CharType* id, const std::locale& loc = std::locale())
+    pgettext(const CharType* context, const CharType* id, const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(context, id).str(loc);
     }
@@ -473,7 +524,7 @@ namespace boost { namespace locale {
                                           const CharType* s,
                                           const CharType* p,
                                           count_type n,
-                                          const std::locale& loc = std::locale())
+                                          const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(context, s, p, n).str(loc);
     }
@@ -481,7 +532,10 @@ namespace boost { namespace locale {
     /// Translate message \a id according to locale \a loc in domain \a domain in context \a context
     template<typename CharType>
     std::basic_string<CharType>
-    dpgettext(const char* domain, const CharType* context, const CharType* id, const std::locale& loc = std::locale())
+    dpgettext(const char* domain,
+              const CharType* context,
+              const CharType* id,
+              const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(context, id).str(loc, domain);
     }
@@ -493,7 +547,7 @@ namespace boost { namespace locale {
                                            const CharType* s,
                                            const CharType* p,
                                            count_type n,
-                                           const std::locale& loc = std::locale())
+                                           const std::locale& loc = default_locale())
     {
         return basic_message<CharType>(context, s, p, n).str(loc, domain);
     }
@@ -6,7 +6,9 @@
 // https://www.boost.org/LICENSE_1_0.txt
 
 #include <boost/locale/encoding.hpp>
+#include "boost/locale/util/encoding.hpp"
 #include "boost/locale/util/make_std_unique.hpp"
+#include <iterator>
 
 #if BOOST_LOCALE_USE_WIN32_API
 #    define BOOST_LOCALE_WITH_WCONV
@@ -23,6 +25,46 @@
 
 namespace boost { namespace locale { namespace conv {
 
+    namespace {
+        /// Names of the known charsets, the id of a charset is its index + 1
+        const char* const charset_names[] = {
+          "UTF-8",        "US-ASCII",     "ISO-8859-1",   "ISO-8859-2",   "ISO-8859-3",   "ISO-8859-4",
+          "ISO-8859-5",   "ISO-8859-6",   "ISO-8859-7",   "ISO-8859-8",   "ISO-8859-9",   "ISO-8859-13",
+          "ISO-8859-15",  "windows-1250", "windows-1251", "windows-1252", "windows-1253", "windows-1254",
+          "windows-1255", "windows-1256", "windows-1257", "KOI8-R",       "KOI8-U",       "Shift_JIS",
+          "EUC-JP",       "EUC-KR",       "GBK",          "GB18030",      "Big5"};
+
+        /// Other names of the known charsets
+        const struct {
+            const char* name;
+            const char* charset;
+        } charset_aliases[] = {{"ascii", "US-ASCII"},
+                               {"latin1", "ISO-8859-1"},
+                               {"cp1250", "windows-1250"},
+                               {"cp1251", "windows-1251"},
+                               {"cp1252", "windows-1252"},
+                               {"cp1253", "windows-1253"},
+                               {"cp1254", "windows-1254"},
+                               {"cp1255", "windows-1255"},
+                               {"cp1256", "windows-1256"},
+                               {"cp1257", "windows-1257"},
+                               {"sjis", "Shift_JIS"},
+                               {"cp936", "GBK"}};
+    } // namespace
+
+    int charset_id(const boost::string_view& charset)
+    {
+        for(const char* const* name = std::begin(charset_names); name != std::end(charset_names); ++name) {
+            if(util::are_encodings_equal(charset, *name))
+                return static_cast<int>(name - std::begin(charset_names)) + 1;
+        }
+        for(const auto& alias : charset_aliases) {
+            if(util::are_encodings_equal(charset, alias.name))
+                return charset_id(alias.charset);
+        }
+        return 0;
+    }
+
     std::string between(const char* begin,
                         const char* end,
                         const std::string& to_charset,
@@ -56,6 +98,9 @@ namespace boost { namespace locale { namespace conv {
     template<typename CharType>
     std::basic_string<CharType> to_utf(const char* begin, const char* end, const std::string& charset, method_type how)
     {
+        // No need to open a converter when the input is already UTF
+        if(util::is_utf8_encoding(charset))
+            return utf_to_utf<CharType>(begin, end, how);
 #ifdef BOOST_LOCALE_WITH_ICONV
         {
             impl::iconv_to_utf<CharType> cvt;
@@ -83,6 +128,8 @@ namespace boost { namespace locale { namespace conv {
     template<typename CharType>
     std::string from_utf(const CharType* begin, const CharType* end, const std::string& charset, method_type how)
     {
+        if(util::is_utf8_encoding(charset))
+            return utf_to_utf<char>(begin, end, how);
 #ifdef BOOST_LOCALE_WITH_ICONV
         {
             impl::iconv_from_utf<CharType> cvt;
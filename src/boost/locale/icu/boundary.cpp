@@ -137,7 +137,9 @@ namespace boost { namespace locale {
 #if BOOST_LOCALE_ICU_VERSION >= 5502
             UErrorCode err = U_ZERO_ERROR;
             BOOST_LOCALE_START_CONST_CONDITION
-            if(sizeof(CharType) == 2 || (sizeof(CharType) == 1 && util::normalize_encoding(encoding) == "utf8")) {
+            if(sizeof(CharType) == 2
+               || (sizeof(CharType) == 1 && (util::utf8_only || util::is_utf8_encoding(encoding))))
+            {
                 UText ut_stack = UTEXT_INITIALIZER;
                 std::unique_ptr<UText> ut;
                 if(sizeof(CharType) == 1)
@@ -11,6 +11,7 @@
 #include "boost/locale/icu/icu_util.hpp"
 #include "boost/locale/icu/uconv.hpp"
 #include "boost/locale/shared/mo_hash.hpp"
+#include "boost/locale/util/encoding.hpp"
 #include <boost/thread.hpp>
 #include <limits>
 #include <unicode/coll.h>
@@ -167,7 +168,7 @@ namespace boost { namespace locale { namespace impl_icu {
                                             const char* e2,
                                             UErrorCode& status) const
     {
-        if(is_utf8_)
+        if(util::utf8_only || is_utf8_)
             return do_utf8_compare(level, b1, e1, b2, e2, status);
         else
             return do_ustring_compare(level, b1, e1, b2, e2, status);
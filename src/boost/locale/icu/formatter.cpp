@@ -10,11 +10,15 @@
 #include <boost/locale/info.hpp>
 #include "boost/locale/icu/formatters_cache.hpp"
 #include "boost/locale/icu/icu_util.hpp"
+#include "boost/locale/icu/number_profile.hpp"
 #include "boost/locale/icu/time_zone.hpp"
 #include "boost/locale/icu/uconv.hpp"
+#include "boost/locale/shared/ios_prop.hpp"
 #include "boost/locale/util/foreach_char.hpp"
 #include <limits>
 #include <memory>
+#include <string>
+#include <typeinfo>
 #ifdef BOOST_MSVC
 #    pragma warning(push)
 #    pragma warning(disable : 4251) // "identifier" : class "type" needs to have dll-interface...
@@ -32,29 +36,14 @@
 
 namespace boost { namespace locale { namespace impl_icu {
 
-    namespace {
-        // Set the min/max fraction digits for the NumberFormat
-        void set_fraction_digits(icu::NumberFormat& nf, const std::ios_base::fmtflags how, std::streamsize precision)
-        {
-#if BOOST_LOCALE_ICU_VERSION >= 5601
-            // Since ICU 56.1 the integer part counts to the fraction part
-            if(how == std::ios_base::scientific)
-                precision += nf.getMaximumIntegerDigits();
-#endif
-            nf.setMaximumFractionDigits(precision);
-            if(how == std::ios_base::scientific || how == std::ios_base::fixed)
-                nf.setMinimumFractionDigits(precision);
-            else
-                nf.setMinimumFractionDigits(0);
-        }
-    } // namespace
-
     template<typename CharType>
     class number_format : public formatter<CharType> {
     public:
         typedef std::basic_string<CharType> string_type;
 
-        number_format(icu::NumberFormat& fmt, std::string codepage) : cvt_(codepage), icu_fmt_(fmt) {}
+        number_format(std::shared_ptr<const shared_number_format> fmt, std::string codepage) :
+            cvt_(codepage), encoding_(std::move(codepage)), shared_fmt_(std::move(fmt)), profile_loaded_(false)
+        {}
 
         string_type format(double value, size_t& code_points) const override { return do_format(value, code_points); }
         string_type format(int64_t value, size_t& code_points) const override { return do_format(value, code_points); }
@@ -91,23 +80,74 @@ namespace boost { namespace locale { namespace impl_icu {
             return true;
         }
 
+        // The shared format must not be used directly, so use a private copy for the non thread-safe ICU API
+        icu::NumberFormat& icu_fmt() const
+        {
+            if(!icu_fmt_) // Before ICU 66 clone returned a Format*
+                icu_fmt_.reset(static_cast<icu::NumberFormat*>(shared_fmt_->prototype().clone()));
+            return *icu_fmt_;
+        }
+
+        /// The profile converted to string_type on first use, null if not available
+        const basic_number_profile<string_type>* converted_profile() const
+        {
+            if(!profile_loaded_) {
+                const auto to_std = [this](const icu::UnicodeString& str) { return cvt_.std(str); };
+                profile_ = shared_fmt_->converted_profile<string_type>(encoding_, to_std);
+                profile_loaded_ = true;
+            }
+            return profile_.get();
+        }
+
         template<typename ValueType>
         string_type do_format(ValueType value, size_t& code_points) const
         {
+            // Avoid getting the profile for values it can't be used for, e.g. ones close to a rounding boundary
+            const auto* profile = shared_fmt_->profile();
+            if(profile && profile->can_format(value)) {
+                string_type result;
+                code_points = converted_profile()->format(result, value);
+                return result;
+            }
             icu::UnicodeString tmp;
-            icu_fmt_.format(value, tmp);
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+            if(const icu::number::LocalizedNumberFormatter* fmt = shared_fmt_->formatter()) {
+                UErrorCode err = U_ZERO_ERROR;
+                tmp = format_number(*fmt, value, err).toString(err);
+                check_and_throw_icu_error(err, "Failed to format number");
+            } else
+#endif
+                icu_fmt().format(value, tmp);
             code_points = tmp.countChar32();
             return cvt_.std(tmp);
         }
 
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+        static icu::number::FormattedNumber
+        format_number(const icu::number::LocalizedNumberFormatter& fmt, double value, UErrorCode& err)
+        {
+            return fmt.formatDouble(value, err);
+        }
+        template<typename IntType>
+        static icu::number::FormattedNumber
+        format_number(const icu::number::LocalizedNumberFormatter& fmt, IntType value, UErrorCode& err)
+        {
+            return fmt.formatInt(value, err);
+        }
+#endif
+
         template<typename ValueType>
         size_t do_parse(const string_type& str, ValueType& v) const
         {
+            if(const auto* profile = converted_profile()) {
+                if(const size_t len = profile->parse(str.data(), str.data() + str.size(), v))
+                    return len;
+            }
             icu::Formattable val;
             icu::ParsePosition pp;
             icu::UnicodeString tmp = cvt_.icu(str.data(), str.data() + str.size());
 
-            icu_fmt_.parse(tmp, val, pp);
+            icu_fmt().parse(tmp, val, pp);
 
             ValueType tmp_v;
 
@@ -121,7 +161,11 @@ namespace boost { namespace locale { namespace impl_icu {
         }
 
         icu_std_converter<CharType> cvt_;
-        icu::NumberFormat& icu_fmt_;
+        std::string encoding_;
+        std::shared_ptr<const shared_number_format> shared_fmt_;
+        mutable std::shared_ptr<const basic_number_profile<string_type>> profile_;
+        mutable bool profile_loaded_;
+        mutable std::unique_ptr<icu::NumberFormat> icu_fmt_;
     };
 
     template<typename CharType>
@@ -138,19 +182,52 @@ namespace boost { namespace locale { namespace impl_icu {
         size_t parse(const string_type& str, int64_t& value) const override { return do_parse(str, value); }
         size_t parse(const string_type& str, int32_t& value) const override { return do_parse(str, value); }
 
-        date_format(icu::DateFormat& fmt, const std::string& encoding) : cvt_(encoding), icu_fmt_(fmt) {}
-        date_format(std::unique_ptr<icu::DateFormat> fmt, const std::string& encoding) :
-            cvt_(encoding), icu_fmt_holder_(std::move(fmt)), icu_fmt_(*icu_fmt_holder_)
-        {}
+        /// Use the formatters for \a pattern from \a cache
+        date_format(const formatters_cache& cache,
+                    const icu::UnicodeString& pattern,
+                    const std::string& time_zone,
+                    const std::string& encoding) :
+            cvt_(encoding),
+            cache_(&cache), pattern_(pattern), time_zone_(time_zone)
+        {
+            init_time_zone();
+        }
+        /// Use the given formatter
+        date_format(std::unique_ptr<icu::DateFormat> fmt, const std::string& time_zone, const std::string& encoding) :
+            cvt_(encoding), cache_(nullptr), own_fmt_(std::move(fmt)), time_zone_(time_zone)
+        {
+            init_time_zone();
+        }
 
     private:
+        void init_time_zone()
+        {
+            // The default time zone may change so it is resolved on each use
+            if(!time_zone_.empty())
+                tz_.reset(get_time_zone(time_zone_));
+        }
+
+        // The formatter may be kept by a stream, so take a formatter from the cache for each use
+        // and set the time zone which other users may have changed
+        formatters_cache::date_formatter_ptr icu_fmt() const
+        {
+            formatters_cache::date_formatter_ptr fmt =
+              own_fmt_ ? formatters_cache::date_formatter_ptr(own_fmt_.get()) : cache_->date_formatter(pattern_);
+            BOOST_ASSERT(fmt);
+            if(tz_)
+                fmt->setTimeZone(*tz_);
+            else
+                fmt->adoptTimeZone(get_time_zone(time_zone_));
+            return fmt;
+        }
+
         template<typename ValueType>
         size_t do_parse(const string_type& str, ValueType& value) const
         {
             icu::ParsePosition pp;
             icu::UnicodeString tmp = cvt_.icu(str.data(), str.data() + str.size());
 
-            UDate udate = icu_fmt_.parse(tmp, pp);
+            UDate udate = icu_fmt()->parse(tmp, pp);
             if(pp.getIndex() == 0)
                 return 0;
             double date = udate / 1000.0;
@@ -176,118 +253,19 @@ namespace boost { namespace locale { namespace impl_icu {
         {
             UDate date = value * 1000.0; // UDate is time_t in milliseconds
             icu::UnicodeString tmp;
-            icu_fmt_.format(date, tmp);
+            icu_fmt()->format(date, tmp);
             codepoints = tmp.countChar32();
             return cvt_.std(tmp);
         }
 
         icu_std_converter<CharType> cvt_;
-        std::unique_ptr<icu::DateFormat> icu_fmt_holder_;
-        icu::DateFormat& icu_fmt_;
+        const formatters_cache* cache_;
+        icu::UnicodeString pattern_;
+        std::unique_ptr<icu::DateFormat> own_fmt_;
+        std::string time_zone_;
+        std::unique_ptr<icu::TimeZone> tz_;
     };
 
-    icu::UnicodeString strftime_symbol_to_icu(const char c, const formatters_cache& cache)
-    {
-        switch(c) {
-            case 'a': // Abbr Weekday
-                return "EE";
-            case 'A': // Full Weekday
-                return "EEEE";
-            case 'b': // Abbr Month
-                return "MMM";
-            case 'B': // Full Month
-                return "MMMM";
-            case 'c': // DateTime
-                return cache.default_date_time_format();
-            // not supported by ICU ;(
-            //  case 'C': // Century -> 1980 -> 19
-            case 'd': // Day of Month [01,31]
-                return "dd";
-            case 'D': // %m/%d/%y
-                return "MM/dd/yy";
-            case 'e': // Day of Month [1,31]
-                return "d";
-            case 'h': // == b
-                return "MMM";
-            case 'H': // 24 clock hour 00,23
-                return "HH";
-            case 'I': // 12 clock hour 01,12
-                return "hh";
-            case 'j': // day of year 001,366
-                return "D";
-            case 'm': // month as [01,12]
-                return "MM";
-            case 'M': // minute [00,59]
-                return "mm";
-            case 'n': // \n
-                return "\n";
-            case 'p': // am-pm
-                return "a";
-            case 'r': // time with AM/PM %I:%M:%S %p
-                return "hh:mm:ss a";
-            case 'R': // %H:%M
-                return "HH:mm";
-            case 'S': // second [00,61]
-                return "ss";
-            case 't': // \t
-                return "\t";
-            case 'T': // %H:%M:%S
-                return "HH:mm:ss";
-                /*          case 'u': // weekday 1,7 1=Monday
-                            case 'U': // week number of year [00,53] Sunday first
-                            case 'V': // week number of year [01,53] Monday first
-                            case 'w': // weekday 0,7 0=Sunday
-                            case 'W': // week number of year [00,53] Monday first, */
-            case 'x': // Date
-                return cache.default_date_format();
-            case 'X': // Time
-                return cache.default_time_format();
-            case 'y': // Year [00-99]
-                return "yy";
-            case 'Y': // Year 1998
-                return "yyyy";
-            case 'Z': // timezone
-                return "vvvv";
-            case '%': // %
-                return "%";
-            default: return "";
-        }
-    }
-
-    icu::UnicodeString strftime_to_icu(const icu::UnicodeString& ftime, const formatters_cache& cache)
-    {
-        const unsigned len = ftime.length();
-        icu::UnicodeString result;
-        bool escaped = false;
-        for(unsigned i = 0; i < len; i++) {
-            UChar c = ftime[i];
-            if(c == '%') {
-                i++;
-                c = ftime[i];
-                if(c == 'E' || c == 'O') {
-                    i++;
-                    c = ftime[i];
-                }
-                if(escaped) {
-                    result += "'";
-                    escaped = false;
-                }
-                result += strftime_symbol_to_icu(c, cache);
-            } else if(c == '\'')
-                result += "''";
-            else {
-                if(!escaped) {
-                    result += "'";
-                    escaped = true;
-                }
-                result += c;
-            }
-        }
-        if(escaped)
-            result += "'";
-        return result;
-    }
-
     format_len time_flags_to_len(const uint64_t time_flags)
     {
         switch(time_flags) {
@@ -335,6 +313,91 @@ namespace boost { namespace locale { namespace impl_icu {
         }
     }
 
+    namespace {
+        /// Stream property holding the formatter last used for the stream
+        class stream_formatter {
+        public:
+            /// Parameters of the stream which the formatter depends on
+            struct key_type {
+                const std::type_info* char_type;
+                uint64_t display_flags;
+                uint64_t currency_flags;
+                std::ios_base::fmtflags float_flags;
+                std::streamsize precision;
+                // Only set for dates and times
+                uint64_t date_flags;
+                uint64_t time_flags;
+                std::string time_zone; ///< Empty for the default one which date formats resolve on each use
+                std::string pattern;   ///< Representation of the strftime pattern
+
+                bool operator==(const key_type& other) const
+                {
+                    return char_type == other.char_type && display_flags == other.display_flags
+                           && currency_flags == other.currency_flags && float_flags == other.float_flags
+                           && precision == other.precision && date_flags == other.date_flags
+                           && time_flags == other.time_flags && time_zone == other.time_zone
+                           && pattern == other.pattern;
+                }
+            };
+
+            stream_formatter() : valid_(false) {}
+            // Formatters are not shared with copies of the stream format
+            stream_formatter(const stream_formatter&) : valid_(false) {}
+            stream_formatter& operator=(const stream_formatter&) = delete;
+
+            void on_imbue() { valid_ = false; }
+
+            template<typename CharType>
+            const formatter<CharType>* get(std::ios_base& ios, const icu::Locale& locale, const std::string& encoding)
+            {
+                const ios_info& info = ios_info::get(ios);
+                key_type key = {&typeid(CharType),
+                                info.display_flags(),
+                                info.currency_flags(),
+                                ios.flags() & std::ios_base::floatfield,
+                                ios.precision(),
+                                0,
+                                0,
+                                std::string(),
+                                std::string()};
+                if(is_date_format(key.display_flags)) {
+                    key.date_flags = info.date_flags();
+                    key.time_flags = info.time_flags();
+                    key.time_zone = info.time_zone();
+                    if(key.display_flags == flags::strftime) {
+                        const std::basic_string<CharType> pattern = info.date_time_pattern<CharType>();
+                        key.pattern.assign(reinterpret_cast<const char*>(pattern.data()),
+                                           pattern.size() * sizeof(CharType));
+                    }
+                }
+                if(valid_ && key == key_)
+                    return static_cast<const formatter<CharType>*>(formatter_.get());
+                formatter_ = formatter<CharType>::create(ios, locale, encoding);
+                key_ = std::move(key);
+                valid_ = static_cast<bool>(formatter_);
+                return static_cast<const formatter<CharType>*>(formatter_.get());
+            }
+
+        private:
+            static bool is_date_format(const uint64_t disp)
+            {
+                using namespace flags;
+                return disp == date || disp == time || disp == datetime || disp == strftime;
+            }
+
+            std::unique_ptr<base_formatter> formatter_;
+            key_type key_;
+            bool valid_;
+        };
+    } // namespace
+
+    template<typename CharType>
+    const formatter<CharType>*
+    formatter<CharType>::get(std::ios_base& ios, const icu::Locale& locale, const std::string& encoding)
+    {
+        return impl::ios_prop<stream_formatter>::get(ios).get<CharType>(ios, locale, encoding);
+    }
+
     template<typename CharType>
     std::unique_ptr<formatter<CharType>>
     formatter<CharType>::create(std::ios_base& ios, const icu::Locale& locale, const std::string& encoding)
@@ -343,6 +406,10 @@ namespace boost { namespace locale { namespace impl_icu {
 
         const ios_info& info = ios_info::get(ios);
         const formatters_cache& cache = std::use_facet<formatters_cache>(ios.getloc());
+        const std::ios_base::fmtflags how = ios.flags() & std::ios_base::floatfield;
+        const auto make_number_format = [&](num_fmt_type type) -> ptr_type {
+            return ptr_type(new number_format<CharType>(cache.number_format(type, how, ios.precision()), encoding));
+        };
 
         const uint64_t disp = info.display_flags();
         switch(disp) {
@@ -350,97 +417,58 @@ namespace boost { namespace locale { namespace impl_icu {
             case posix:
                 BOOST_ASSERT_MSG(false, "Shouldn't try to create a posix formatter"); // LCOV_EXCL_LINE
                 break;                                                                // LCOV_EXCL_LINE
-            case number: {
-                const std::ios_base::fmtflags how = (ios.flags() & std::ios_base::floatfield);
-                icu::NumberFormat& nf =
-                  cache.number_format((how == std::ios_base::scientific) ? num_fmt_type::sci : num_fmt_type::number);
-                set_fraction_digits(nf, how, ios.precision());
-                return ptr_type(new number_format<CharType>(nf, encoding));
-            }
-            case currency: {
-                icu::NumberFormat& nf = cache.number_format(
-                  (info.currency_flags() == currency_iso) ? num_fmt_type::curr_iso : num_fmt_type::curr_nat);
-                return ptr_type(new number_format<CharType>(nf, encoding));
-            }
-            case percent: {
-                icu::NumberFormat& nf = cache.number_format(num_fmt_type::percent);
-                set_fraction_digits(nf, ios.flags() & std::ios_base::floatfield, ios.precision());
-                return ptr_type(new number_format<CharType>(nf, encoding));
-            }
-            case spellout:
-                return ptr_type(new number_format<CharType>(cache.number_format(num_fmt_type::spell), encoding));
-            case ordinal:
-                return ptr_type(new number_format<CharType>(cache.number_format(num_fmt_type::ordinal), encoding));
+            case number:
+                return make_number_format((how == std::ios_base::scientific) ? num_fmt_type::sci :
+                                                                                num_fmt_type::number);
+            case currency:
+                return make_number_format((info.currency_flags() == currency_iso) ? num_fmt_type::curr_iso :
+                                                                                     num_fmt_type::curr_nat);
+            case percent: return make_number_format(num_fmt_type::percent);
+            case spellout: return make_number_format(num_fmt_type::spell);
+            case ordinal: return make_number_format(num_fmt_type::ordinal);
             case date:
             case time:
             case datetime:
             case strftime: {
                 using namespace flags;
-                std::unique_ptr<icu::DateFormat> new_df;
-                icu::DateFormat* df = nullptr;
-                // try to use cached first
-                {
-                    icu::SimpleDateFormat* sdf = cache.date_formatter();
-                    if(sdf) {
-                        icu::UnicodeString pattern;
-                        switch(disp) {
-                            case date: pattern = cache.date_format(date_flags_to_len(info.date_flags())); break;
-                            case time: pattern = cache.time_format(time_flags_to_len(info.time_flags())); break;
-                            case datetime:
-                                pattern = cache.date_time_format(date_flags_to_len(info.date_flags()),
-                                                                 time_flags_to_len(info.time_flags()));
-                                break;
-                            case strftime: {
-                                icu_std_converter<CharType> cvt_(encoding);
-                                const std::basic_string<CharType> f = info.date_time_pattern<CharType>();
-                                pattern = strftime_to_icu(cvt_.icu(f.c_str(), f.c_str() + f.size()), locale);
-                            } break;
-                        }
-                        if(!pattern.isEmpty()) {
-                            sdf->applyPattern(pattern);
-                            df = sdf;
-                        }
-                    }
+                icu::UnicodeString pattern;
+                switch(disp) {
+                    case date: pattern = cache.date_format(date_flags_to_len(info.date_flags())); break;
+                    case time: pattern = cache.time_format(time_flags_to_len(info.time_flags())); break;
+                    case datetime:
+                        pattern = cache.date_time_format(date_flags_to_len(info.date_flags()),
+                                                         time_flags_to_len(info.time_flags()));
+                        break;
+                    case strftime: {
+                        icu_std_converter<CharType> cvt_(encoding);
+                        const std::basic_string<CharType> f = info.date_time_pattern<CharType>();
+                        pattern = cache.strftime_to_icu(cvt_.icu(f.data(), f.data() + f.size()));
+                    } break;
                 }
-
-                if(!df) {
-                    switch(disp) {
-                        case date:
-                            new_df.reset(
-                              icu::DateFormat::createDateInstance(date_flags_to_icu_len(info.date_flags()), locale));
-                            break;
-                        case time:
-                            new_df.reset(
-                              icu::DateFormat::createTimeInstance(time_flags_to_icu_len(info.time_flags()), locale));
-                            break;
-                        case datetime:
-                            new_df.reset(
-                              icu::DateFormat::createDateTimeInstance(date_flags_to_icu_len(info.date_flags()),
-                                                                      time_flags_to_icu_len(info.time_flags()),
-                                                                      locale));
-                            break;
-                        case strftime: {
-                            icu_std_converter<CharType> cvt_(encoding);
-                            const std::basic_string<CharType> f = info.date_time_pattern<CharType>();
-                            icu::UnicodeString pattern =
-                              strftime_to_icu(cvt_.icu(f.data(), f.data() + f.size()), locale);
-                            UErrorCode err = U_ZERO_ERROR;
-                            new_df.reset(new icu::SimpleDateFormat(pattern, locale, err));
-                            if(U_FAILURE(err))
-                                return nullptr;
-                        } break;
-                    }
-                    df = new_df.get();
-                    BOOST_ASSERT_MSG(df, "Failed to create date/time formatter");
+                if(!pattern.isEmpty() && cache.date_formatter(pattern))
+                    return ptr_type(new date_format<CharType>(cache, pattern, info.time_zone(), encoding));
+                std::unique_ptr<icu::DateFormat> df;
+                switch(disp) {
+                    case date:
+                        df.reset(icu::DateFormat::createDateInstance(date_flags_to_icu_len(info.date_flags()), locale));
+                        break;
+                    case time:
+                        df.reset(icu::DateFormat::createTimeInstance(time_flags_to_icu_len(info.time_flags()), locale));
+                        break;
+                    case datetime:
+                        df.reset(icu::DateFormat::createDateTimeInstance(date_flags_to_icu_len(info.date_flags()),
+                                                                         time_flags_to_icu_len(info.time_flags()),
+                                                                         locale));
+                        break;
+                    case strftime: {
+                        UErrorCode err = U_ZERO_ERROR;
+                        df.reset(new icu::SimpleDateFormat(pattern, locale, err));
+                        if(U_FAILURE(err))
+                            return nullptr;
+                    } break;
                 }
-
-                df->adoptTimeZone(get_time_zone(info.time_zone()));
-
-                // Depending if we own formatter or not
-                if(new_df)
-                    return ptr_type(new date_format<CharType>(std::move(new_df), encoding));
-                else
-                    return ptr_type(new date_format<CharType>(*df, encoding));
+                BOOST_ASSERT_MSG(df, "Failed to create date/time formatter");
+                return ptr_type(new date_format<CharType>(std::move(df), info.time_zone(), encoding));
             } break;
         }
 
@@ -65,6 +65,13 @@ namespace boost { namespace locale { namespace impl_icu {
         ///
         static std::unique_ptr<formatter>
         create(std::ios_base& ios, const icu::Locale& locale, const std::string& encoding);
+
+        /// Get formatter for the current state of ios_base like \ref create
+        ///
+        /// The formatter is stored in \a ios and reused by following calls until the flags, the precision,
+        /// the time zone, the date/time pattern or the locale of \a ios change.
+        /// It stays valid until the next call for the same stream.
+        static const formatter* get(std::ios_base& ios, const icu::Locale& locale, const std::string& encoding);
     }; // class formatter
 
 }}} // namespace boost::locale::impl_icu
@@ -8,13 +8,17 @@
 #include "boost/locale/icu/formatters_cache.hpp"
 #include <boost/assert.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <map>
 #include <memory>
-#include <type_traits>
+#include <string>
+#include <tuple>
+#include <vector>
 #ifdef BOOST_MSVC
 #    pragma warning(push)
 #    pragma warning(disable : 4251) // "identifier" : class "type" needs to have dll-interface...
 #endif
 #include <unicode/datefmt.h>
+#include <unicode/decimfmt.h>
 #include <unicode/numfmt.h>
 #include <unicode/rbnf.h>
 #include <unicode/smpdtfmt.h>
@@ -44,42 +48,220 @@ namespace boost { namespace locale { namespace impl_icu {
         {
             return get_icu_pattern(std::unique_ptr<icu::DateFormat>(fmt), out_str);
         }
-    } // namespace
 
-    formatters_cache::formatters_cache(const icu::Locale& locale) : locale_(locale)
-    {
-#define BOOST_LOCALE_ARRAY_SIZE(T) std::extent<typename std::remove_reference<decltype(T)>::type>::value
-        constexpr icu::DateFormat::EStyle styles[]{icu::DateFormat::kShort,
-                                                   icu::DateFormat::kMedium,
-                                                   icu::DateFormat::kLong,
-                                                   icu::DateFormat::kFull};
-        constexpr int num_styles = BOOST_LOCALE_ARRAY_SIZE(styles);
-
-        static_assert(num_styles == BOOST_LOCALE_ARRAY_SIZE(date_format_), "!");
-        for(int i = 0; i < num_styles; i++)
-            get_icu_pattern(icu::DateFormat::createDateInstance(styles[i], locale), date_format_[i]);
-
-        static_assert(num_styles == BOOST_LOCALE_ARRAY_SIZE(time_format_), "!");
-        for(int i = 0; i < num_styles; i++)
-            get_icu_pattern(icu::DateFormat::createTimeInstance(styles[i], locale), time_format_[i]);
-
-        static_assert(num_styles == BOOST_LOCALE_ARRAY_SIZE(date_time_format_), "!");
-        static_assert(num_styles == BOOST_LOCALE_ARRAY_SIZE(date_time_format_[0]), "!");
-        for(int i = 0; i < num_styles; i++) {
-            for(int j = 0; j < num_styles; j++) {
-                get_icu_pattern(icu::DateFormat::createDateTimeInstance(styles[i], styles[j], locale),
-                                date_time_format_[i][j]);
+        icu::DateFormat::EStyle to_icu_style(format_len f)
+        {
+            switch(f) {
+                case format_len::Short: return icu::DateFormat::kShort;
+                case format_len::Medium: return icu::DateFormat::kMedium;
+                case format_len::Long: return icu::DateFormat::kLong;
+                case format_len::Full: return icu::DateFormat::kFull;
             }
+            return icu::DateFormat::kDefault; // LCOV_EXCL_LINE
+        }
+
+        icu::UnicodeString get_str_or(const icu::UnicodeString& str, const char* default_str)
+        {
+            return str.isEmpty() ? icu::UnicodeString(default_str) : str;
+        }
+
+        // Set the min/max fraction digits for the NumberFormat
+        void set_fraction_digits(icu::NumberFormat& nf, const std::ios_base::fmtflags how, std::streamsize precision)
+        {
+#if BOOST_LOCALE_ICU_VERSION >= 5601
+            // Since ICU 56.1 the integer part counts to the fraction part
+            if(how == std::ios_base::scientific)
+                precision += nf.getMaximumIntegerDigits();
+#endif
+            nf.setMaximumFractionDigits(precision);
+            if(how == std::ios_base::scientific || how == std::ios_base::fixed)
+                nf.setMinimumFractionDigits(precision);
+            else
+                nf.setMinimumFractionDigits(0);
         }
-#undef BOOST_LOCALE_ARRAY_SIZE
 
-        const auto get_str_or = [](const icu::UnicodeString& str, const char* default_str) {
-            return str.isEmpty() ? default_str : str;
+        bool uses_precision(num_fmt_type type)
+        {
+            return type == num_fmt_type::number || type == num_fmt_type::sci || type == num_fmt_type::percent;
+        }
+
+        /// Number formats of all locales, as each generated locale has its own facet
+        struct number_format_cache {
+            typedef std::tuple<std::string, num_fmt_type, std::ios_base::fmtflags, std::streamsize> key_type;
+            boost::mutex lock;
+            std::map<key_type, std::shared_ptr<const shared_number_format>> formats;
         };
-        default_date_format_ = get_str_or(date_format(format_len::Medium), "yyyy-MM-dd");
-        default_time_format_ = get_str_or(time_format(format_len::Medium), "HH:mm:ss");
-        default_date_time_format_ =
-          get_str_or(date_time_format(format_len::Full, format_len::Full), "yyyy-MM-dd HH:mm:ss");
+        number_format_cache& get_number_format_cache()
+        {
+            static number_format_cache instance;
+            return instance;
+        }
+
+        icu::UnicodeString strftime_symbol_to_icu(const char c, const formatters_cache& cache)
+        {
+            switch(c) {
+                case 'a': // Abbr Weekday
+                    return "EE";
+                case 'A': // Full Weekday
+                    return "EEEE";
+                case 'b': // Abbr Month
+                    return "MMM";
+                case 'B': // Full Month
+                    return "MMMM";
+                case 'c': // DateTime
+                    return cache.default_date_time_format();
+                // not supported by ICU ;(
+                //  case 'C': // Century -> 1980 -> 19
+                case 'd': // Day of Month [01,31]
+                    return "dd";
+                case 'D': // %m/%d/%y
+                    return "MM/dd/yy";
+                case 'e': // Day of Month [1,31]
+                    return "d";
+                case 'h': // == b
+                    return "MMM";
+                case 'H': // 24 clock hour 00,23
+                    return "HH";
+                case 'I': // 12 clock hour 01,12
+                    return "hh";
+                case 'j': // day of year 001,366
+                    return "D";
+                case 'm': // month as [01,12]
+                    return "MM";
+                case 'M': // minute [00,59]
+                    return "mm";
+                case 'n': // \n
+                    return "\n";
+                case 'p': // am-pm
+                    return "a";
+                case 'r': // time with AM/PM %I:%M:%S %p
+                    return "hh:mm:ss a";
+                case 'R': // %H:%M
+                    return "HH:mm";
+                case 'S': // second [00,61]
+                    return "ss";
+                case 't': // \t
+                    return "\t";
+                case 'T': // %H:%M:%S
+                    return "HH:mm:ss";
+                    /*          case 'u': // weekday 1,7 1=Monday
+                                case 'U': // week number of year [00,53] Sunday first
+                                case 'V': // week number of year [01,53] Monday first
+                                case 'w': // weekday 0,7 0=Sunday
+                                case 'W': // week number of year [00,53] Monday first, */
+                case 'x': // Date
+                    return cache.default_date_format();
+                case 'X': // Time
+                    return cache.default_time_format();
+                case 'y': // Year [00-99]
+                    return "yy";
+                case 'Y': // Year 1998
+                    return "yyyy";
+                case 'Z': // timezone
+                    return "vvvv";
+                case '%': // %
+                    return "%";
+                default: return "";
+            }
+        }
+
+        icu::UnicodeString convert_strftime(const icu::UnicodeString& ftime, const formatters_cache& cache)
+        {
+            const unsigned len = ftime.length();
+            icu::UnicodeString result;
+            bool escaped = false;
+            for(unsigned i = 0; i < len; i++) {
+                UChar c = ftime[i];
+                if(c == '%') {
+                    i++;
+                    c = ftime[i];
+                    if(c == 'E' || c == 'O') {
+                        i++;
+                        c = ftime[i];
+                    }
+                    if(escaped) {
+                        result += "'";
+                        escaped = false;
+                    }
+                    result += strftime_symbol_to_icu(c, cache);
+                } else if(c == '\'')
+                    result += "''";
+                else {
+                    if(!escaped) {
+                        result += "'";
+                        escaped = true;
+                    }
+                    result += c;
+                }
+            }
+            if(escaped)
+                result += "'";
+            return result;
+        }
+    } // namespace
+
+    shared_number_format::shared_number_format(num_fmt_type type, std::unique_ptr<icu::NumberFormat> fmt) :
+        fmt_(std::move(fmt))
+    {
+        // Only plain numbers, the other types have too many special cases
+        if(type == num_fmt_type::number)
+            profile_ = create_number_profile(*fmt_);
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+        formatter_ = nullptr;
+        if(const icu::DecimalFormat* dfmt = icu_cast<const icu::DecimalFormat>(fmt_.get())) {
+            UErrorCode err = U_ZERO_ERROR;
+            formatter_ = dfmt->toNumberFormatter(err);
+            if(U_FAILURE(err))
+                formatter_ = nullptr; // LCOV_EXCL_LINE
+        }
+#endif
+    }
+
+    formatters_cache::formatters_cache(const icu::Locale& locale) : locale_(locale) {}
+
+    template<typename Creator>
+    icu::UnicodeString formatters_cache::get_pattern(lazy_pattern& p, Creator create) const
+    {
+        boost::unique_lock<boost::mutex> guard(patterns_lock_);
+        if(!p.initialized) {
+            get_icu_pattern(create(), p.pattern);
+            p.initialized = true;
+        }
+        return p.pattern;
+    }
+
+    icu::UnicodeString formatters_cache::date_format(format_len f) const
+    {
+        return get_pattern(date_format_[int(f)],
+                           [&]() { return icu::DateFormat::createDateInstance(to_icu_style(f), locale_); });
+    }
+
+    icu::UnicodeString formatters_cache::time_format(format_len f) const
+    {
+        return get_pattern(time_format_[int(f)],
+                           [&]() { return icu::DateFormat::createTimeInstance(to_icu_style(f), locale_); });
+    }
+
+    icu::UnicodeString formatters_cache::date_time_format(format_len d, format_len t) const
+    {
+        return get_pattern(date_time_format_[int(d)][int(t)], [&]() {
+            return icu::DateFormat::createDateTimeInstance(to_icu_style(d), to_icu_style(t), locale_);
+        });
+    }
+
+    icu::UnicodeString formatters_cache::default_date_format() const
+    {
+        return get_str_or(date_format(format_len::Medium), "yyyy-MM-dd");
+    }
+
+    icu::UnicodeString formatters_cache::default_time_format() const
+    {
+        return get_str_or(time_format(format_len::Medium), "HH:mm:ss");
+    }
+
+    icu::UnicodeString formatters_cache::default_date_time_format() const
+    {
+        return get_str_or(date_time_format(format_len::Full, format_len::Full), "yyyy-MM-dd HH:mm:ss");
     }
 
     icu::NumberFormat* formatters_cache::create_number_format(num_fmt_type type, UErrorCode& err) const
@@ -110,34 +292,115 @@ namespace boost { namespace locale { namespace impl_icu {
         throw std::logic_error("locale::internal error should not get there"); // LCOV_EXCL_LINE
     }
 
-    icu::NumberFormat& formatters_cache::number_format(num_fmt_type type) const
+    std::shared_ptr<const shared_number_format>
+    formatters_cache::number_format(num_fmt_type type, std::ios_base::fmtflags how, std::streamsize precision) const
     {
-        icu::NumberFormat* result = number_format_[int(type)].get();
-        if(!result) {
-            UErrorCode err = U_ZERO_ERROR;
-            std::unique_ptr<icu::NumberFormat> new_ptr(create_number_format(type, err));
-            check_and_throw_icu_error(err, "Failed to create a formatter");
-            result = new_ptr.get();
-            BOOST_ASSERT(result);
-            number_format_[int(type)].reset(new_ptr.release());
+        if(!uses_precision(type)) {
+            how = std::ios_base::fmtflags();
+            precision = 0;
+        }
+        number_format_cache& cache = get_number_format_cache();
+        const number_format_cache::key_type key(locale_.getName(), type, how, precision);
+        {
+            boost::unique_lock<boost::mutex> guard(cache.lock);
+            const auto it = cache.formats.find(key);
+            if(it != cache.formats.end())
+                return it->second;
+        }
+        UErrorCode err = U_ZERO_ERROR;
+        std::unique_ptr<icu::NumberFormat> fmt(create_number_format(type, err));
+        check_and_throw_icu_error(err, "Failed to create a formatter");
+        BOOST_ASSERT(fmt);
+        if(uses_precision(type))
+            set_fraction_digits(*fmt, how, precision);
+        std::shared_ptr<const shared_number_format> result =
+          std::make_shared<shared_number_format>(type, std::move(fmt));
+
+        boost::unique_lock<boost::mutex> guard(cache.lock);
+        if(cache.formats.size() >= max_cached_formats)
+            cache.formats.clear();
+        // Another thread might have been faster in which case its format is used
+        return cache.formats.emplace(key, std::move(result)).first->second;
+    }
+
+    class formatters_cache::date_format_pool {
+    public:
+        explicit date_format_pool(std::unique_ptr<icu::DateFormat> prototype) : prototype_(std::move(prototype)) {}
+
+        std::unique_ptr<icu::DateFormat> take()
+        {
+            {
+                boost::unique_lock<boost::mutex> guard(lock_);
+                if(!formats_.empty()) {
+                    std::unique_ptr<icu::DateFormat> fmt = std::move(formats_.back());
+                    formats_.pop_back();
+                    return fmt;
+                }
+            }
+            // The prototype is never modified, so it can be cloned concurrently.
+            // Before ICU 66 clone returned a Format*
+            return std::unique_ptr<icu::DateFormat>(static_cast<icu::DateFormat*>(prototype_->clone()));
         }
-        return *result;
+
+        void give_back(std::unique_ptr<icu::DateFormat> fmt)
+        {
+            boost::unique_lock<boost::mutex> guard(lock_);
+            // At most as many formatters as were used at the same time are kept
+            if(formats_.size() < max_cached_formats)
+                formats_.push_back(std::move(fmt));
+        }
+
+    private:
+        const std::unique_ptr<const icu::DateFormat> prototype_;
+        boost::mutex lock_;
+        std::vector<std::unique_ptr<icu::DateFormat>> formats_;
+    };
+
+    void formatters_cache::date_formatter_deleter::operator()(icu::DateFormat* fmt) const
+    {
+        if(pool)
+            pool->give_back(std::unique_ptr<icu::DateFormat>(fmt));
     }
 
-    icu::SimpleDateFormat* formatters_cache::date_formatter() const
+    formatters_cache::date_formatter_ptr formatters_cache::date_formatter(const icu::UnicodeString& pattern) const
     {
-        icu::SimpleDateFormat* result = date_formatter_.get();
-        if(!result) {
+        std::shared_ptr<date_format_pool> pool;
+        {
+            boost::unique_lock<boost::mutex> guard(date_formats_lock_);
+            const auto it = date_formats_.find(pattern);
+            if(it != date_formats_.end())
+                pool = it->second;
+        }
+        if(!pool) {
             std::unique_ptr<icu::DateFormat> fmt(
               icu::DateFormat::createDateTimeInstance(icu::DateFormat::kMedium, icu::DateFormat::kMedium, locale_));
+            icu::SimpleDateFormat* sfmt = icu_cast<icu::SimpleDateFormat>(fmt.get());
+            if(!sfmt)
+                return nullptr; // LCOV_EXCL_LINE
+            sfmt->applyPattern(pattern);
+            pool = std::make_shared<date_format_pool>(std::move(fmt));
 
-            result = icu_cast<icu::SimpleDateFormat>(fmt.get());
-            if(result) {
-                fmt.release();
-                date_formatter_.reset(result);
-            }
+            boost::unique_lock<boost::mutex> guard(date_formats_lock_);
+            // Formatters still in use keep their pool alive and are freed when returned
+            if(date_formats_.size() >= max_cached_formats)
+                date_formats_.clear();
+            // Another thread might have been faster in which case its pool is used
+            pool = date_formats_.emplace(pattern, std::move(pool)).first->second;
+        }
+        std::unique_ptr<icu::DateFormat> fmt = pool->take();
+        return date_formatter_ptr(fmt.release(), date_formatter_deleter{std::move(pool)});
+    }
+
+    icu::UnicodeString formatters_cache::strftime_to_icu(const icu::UnicodeString& ftime) const
+    {
+        boost::unique_lock<boost::mutex> guard(date_formats_lock_);
+        auto it = strftime_patterns_.find(ftime);
+        if(it == strftime_patterns_.end()) {
+            if(strftime_patterns_.size() >= max_cached_formats)
+                strftime_patterns_.clear();
+            it = strftime_patterns_.emplace(ftime, convert_strftime(ftime, *this)).first;
         }
-        return result;
+        return it->second;
     }
 
 }}} // namespace boost::locale::impl_icu
@@ -10,8 +10,15 @@
 
 #include <boost/locale/config.hpp>
 #include "boost/locale/icu/icu_util.hpp"
-#include <boost/thread/tss.hpp>
+#include "boost/locale/icu/number_profile.hpp"
+#include <boost/thread/mutex.hpp>
+#include <ios>
 #include <locale>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
 
 #ifdef BOOST_MSVC
 #    pragma warning(push)
@@ -20,6 +27,9 @@
 #include <unicode/locid.h>
 #include <unicode/numfmt.h>
 #include <unicode/smpdtfmt.h>
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+#    include <unicode/numberformatter.h>
+#endif
 #ifdef BOOST_MSVC
 #    pragma warning(pop)
 #endif
@@ -35,41 +45,114 @@ namespace boost { namespace locale { namespace impl_icu {
 
     enum class num_fmt_type { number, sci, curr_nat, curr_iso, percent, spell, ordinal };
 
-    class formatters_cache : public std::locale::facet {
+    /// Number format for a fixed style, precision and rounding which is never modified once created
+    /// and hence can be shared between threads
+    class shared_number_format {
     public:
-        static std::locale::id id;
-
-        formatters_cache(const icu::Locale& locale);
+        shared_number_format(num_fmt_type type, std::unique_ptr<icu::NumberFormat> fmt);
 
-        icu::NumberFormat& number_format(num_fmt_type type) const;
-
-        const icu::UnicodeString& date_format(format_len f) const { return date_format_[int(f)]; }
-
-        const icu::UnicodeString& time_format(format_len f) const { return time_format_[int(f)]; }
-
-        const icu::UnicodeString& date_time_format(format_len d, format_len t) const
+        /// The configured format. Must only be used for cloning as it is not safe to use it concurrently
+        const icu::NumberFormat& prototype() const { return *fmt_; }
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+        /// Immutable and thread-safe formatter equivalent to the prototype, null if not available (e.g. spellout)
+        const icu::number::LocalizedNumberFormatter* formatter() const { return formatter_; }
+#endif
+        /// Profile to write integral values without ICU, null if not supported for this format
+        const number_profile* profile() const { return profile_.get(); }
+
+        /// The profile with its symbols converted to \a StringType in the \a encoding using \a cvt,
+        /// null if not supported for this format. The conversion is done once for each string type and encoding.
+        template<typename StringType, typename Converter>
+        std::shared_ptr<const basic_number_profile<StringType>> converted_profile(const std::string& encoding,
+                                                                                 const Converter& cvt) const
         {
-            return date_time_format_[int(d)][int(t)];
+            if(!profile_)
+                return nullptr;
+            const converted_profile_key key(typeid(StringType), encoding);
+            {
+                boost::unique_lock<boost::mutex> guard(converted_profiles_lock_);
+                const auto it = converted_profiles_.find(key);
+                if(it != converted_profiles_.end())
+                    return std::static_pointer_cast<const basic_number_profile<StringType>>(it->second);
+            }
+            std::shared_ptr<const void> result =
+              std::make_shared<basic_number_profile<StringType>>(profile_->convert<StringType>(cvt));
+            boost::unique_lock<boost::mutex> guard(converted_profiles_lock_);
+            result = converted_profiles_.emplace(key, std::move(result)).first->second;
+            return std::static_pointer_cast<const basic_number_profile<StringType>>(result);
         }
 
-        const icu::UnicodeString& default_date_format() const { return default_date_format_; }
-        const icu::UnicodeString& default_time_format() const { return default_time_format_; }
-        const icu::UnicodeString& default_date_time_format() const { return default_date_time_format_; }
+    private:
+        std::unique_ptr<icu::NumberFormat> fmt_;
+        std::unique_ptr<const number_profile> profile_;
+        typedef std::pair<std::type_index, std::string> converted_profile_key;
+        mutable boost::mutex converted_profiles_lock_;
+        mutable std::map<converted_profile_key, std::shared_ptr<const void>> converted_profiles_;
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+        const icu::number::LocalizedNumberFormatter* formatter_; // Owned by fmt_
+#endif
+    };
+
+    class formatters_cache : public std::locale::facet {
+    public:
+        static std::locale::id id;
+
+        formatters_cache(const icu::Locale& locale);
 
-        icu::SimpleDateFormat* date_formatter() const;
+        /// Get the format of the given type with the fraction digits set for the precision
+        /// and the floatfield flags \a how. Formats are created once per locale and shared by all users
+        /// in the process, also those of other facets for the same locale.
+        std::shared_ptr<const shared_number_format>
+        number_format(num_fmt_type type, std::ios_base::fmtflags how, std::streamsize precision) const;
+
+        // The date and time patterns are created on first use
+        icu::UnicodeString date_format(format_len f) const;
+        icu::UnicodeString time_format(format_len f) const;
+        icu::UnicodeString date_time_format(format_len d, format_len t) const;
+
+        icu::UnicodeString default_date_format() const;
+        icu::UnicodeString default_time_format() const;
+        icu::UnicodeString default_date_time_format() const;
+
+        /// Clones of the date format for one pattern of which each is used by a single user at a time
+        class date_format_pool;
+        /// Returns a date formatter to its pool. Does nothing for formatters not taken from a pool.
+        struct date_formatter_deleter {
+            std::shared_ptr<date_format_pool> pool;
+            void operator()(icu::DateFormat* fmt) const;
+        };
+        typedef std::unique_ptr<icu::DateFormat, date_formatter_deleter> date_formatter_ptr;
+
+        /// Take a date formatter using the ICU \a pattern from the cache or return null if it can't be created.
+        /// The caller has exclusive use of it until it is destroyed, which returns it to the cache.
+        /// Its time zone is changed by other users so it must be set before each use.
+        date_formatter_ptr date_formatter(const icu::UnicodeString& pattern) const;
+
+        /// Convert a strftime-like pattern to an ICU pattern. The results are cached.
+        icu::UnicodeString strftime_to_icu(const icu::UnicodeString& ftime) const;
 
     private:
         icu::NumberFormat* create_number_format(num_fmt_type type, UErrorCode& err) const;
 
-        static constexpr auto num_fmt_type_count = static_cast<unsigned>(num_fmt_type::ordinal) + 1;
+        static constexpr size_t max_cached_formats = 64;
         static constexpr auto format_len_count = static_cast<unsigned>(format_len::Full) + 1;
 
-        mutable boost::thread_specific_ptr<icu::NumberFormat> number_format_[num_fmt_type_count];
-        icu::UnicodeString date_format_[format_len_count];
-        icu::UnicodeString time_format_[format_len_count];
-        icu::UnicodeString date_time_format_[format_len_count][format_len_count];
-        icu::UnicodeString default_date_format_, default_time_format_, default_date_time_format_;
-        mutable boost::thread_specific_ptr<icu::SimpleDateFormat> date_formatter_;
+        struct lazy_pattern {
+            bool initialized = false;
+            icu::UnicodeString pattern;
+        };
+        template<typename Creator>
+        icu::UnicodeString get_pattern(lazy_pattern& p, Creator create) const;
+
+        mutable boost::mutex patterns_lock_;
+        mutable lazy_pattern date_format_[format_len_count];
+        mutable lazy_pattern time_format_[format_len_count];
+        mutable lazy_pattern date_time_format_[format_len_count][format_len_count];
+
+        mutable boost::mutex date_formats_lock_;
+        // Formatters for each pattern which are cloned from a prototype so the pattern is only parsed once
+        mutable std::map<icu::UnicodeString, std::shared_ptr<date_format_pool>> date_formats_;
+        mutable std::map<icu::UnicodeString, icu::UnicodeString> strftime_patterns_;
         icu::Locale locale_;
     };
 
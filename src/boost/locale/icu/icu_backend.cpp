@@ -12,17 +12,22 @@
 #include <boost/locale/util/locale_data.hpp>
 #include "boost/locale/icu/all_generator.hpp"
 #include "boost/locale/icu/cdata.hpp"
+#include "boost/locale/icu/icu_data.hpp"
+#include "boost/locale/util/c_locale_facets.hpp"
+#include "boost/locale/util/encoding.hpp"
+#include "boost/locale/util/lazy_facets.hpp"
 #include "boost/locale/util/make_std_unique.hpp"
 
+#include <functional>
 #include <unicode/ucnv.h>
 
 namespace boost { namespace locale { namespace impl_icu {
     class icu_localization_backend : public localization_backend {
     public:
-        icu_localization_backend() : invalid_(true), use_ansi_encoding_(false) {}
+        icu_localization_backend() : invalid_(true), use_ansi_encoding_(false), lazy_facets_(false) {}
         icu_localization_backend(const icu_localization_backend& other) :
             localization_backend(), paths_(other.paths_), domains_(other.domains_), locale_id_(other.locale_id_),
-            invalid_(true), use_ansi_encoding_(other.use_ansi_encoding_)
+            invalid_(true), use_ansi_encoding_(other.use_ansi_encoding_), lazy_facets_(other.lazy_facets_)
         {}
         icu_localization_backend* clone() const override { return new icu_localization_backend(*this); }
 
@@ -37,11 +42,14 @@ namespace boost { namespace locale { namespace impl_icu {
                 domains_.push_back(value);
             else if(name == "use_ansi_encoding")
                 use_ansi_encoding_ = value == "true";
+            else if(name == "lazy_facets")
+                lazy_facets_ = value == "true";
         }
         void clear_options() override
         {
             invalid_ = true;
             use_ansi_encoding_ = false;
+            lazy_facets_ = false;
             locale_id_.clear();
             paths_.clear();
             domains_.clear();
@@ -60,11 +68,18 @@ namespace boost { namespace locale { namespace impl_icu {
 
             util::locale_data d;
             d.parse(real_id_);
+            util::check_narrow_encoding(d.encoding());
 
             data_.locale = icu::Locale::createCanonical(real_id_.c_str());
             data_.encoding = d.encoding();
-            data_.utf8 = d.is_utf8();
+            data_.utf8 = util::utf8_only || d.is_utf8();
             language_ = d.language();
+            c_locale_ = language_ == "C";
+#ifdef BOOST_LOCALE_ICU_EMBEDDED_DATA
+            // Trimmed data would silently fall back to the root locale
+            if(!c_locale_ && !has_locale_data(data_.locale))
+                throw std::runtime_error("Locale '" + real_id_ + "' is missing from the embedded ICU data");
+#endif
             country_ = d.country();
             variant_ = d.variant();
         }
@@ -73,37 +88,48 @@ namespace boost { namespace locale { namespace impl_icu {
         {
             prepare_data();
 
+            if(c_locale_) {
+                switch(category) {
+                    case category_t::convert: return util::create_c_converter(create_convert(base, data_, type), type);
+                    case category_t::collation:
+                        // Keep ICU's root collation for the lower levels, e.g. ignoring case for the primary one
+                        return util::create_c_collate(create_collate(base, data_, type), type, true);
+                    default: break;
+                }
+            }
+
+            if(lazy_facets_) {
+                // Defer the creation of facets which are expensive to create but often unused
+                const cdata data = data_;
+                switch(category) {
+                    case category_t::convert:
+                        return install_lazy<util::lazy_converter>(
+                          base,
+                          type,
+                          [data, type]() { return create_convert(std::locale::classic(), data, type); });
+                    case category_t::collation:
+                        return install_lazy<util::lazy_collator>(
+                          base,
+                          type,
+                          [data, type]() { return create_collate(std::locale::classic(), data, type); });
+                    case category_t::message: {
+                        const gnu_gettext::messages_info minf = messages_info();
+                        return install_lazy<util::lazy_message_format>(
+                          base,
+                          type,
+                          [minf, type]() { return create_messages(std::locale::classic(), minf, type); });
+                    }
+                    default: break;
+                }
+            }
+
             switch(category) {
                 case category_t::convert: return create_convert(base, data_, type);
                 case category_t::collation: return create_collate(base, data_, type);
                 case category_t::formatting: return create_formatting(base, data_, type);
                 case category_t::parsing: return create_parsing(base, data_, type);
                 case category_t::codepage: return create_codecvt(base, data_.encoding, type);
-                case category_t::message: {
-                    gnu_gettext::messages_info minf;
-                    minf.language = language_;
-                    minf.country = country_;
-                    minf.variant = variant_;
-                    minf.encoding = data_.encoding;
-                    minf.domains = gnu_gettext::messages_info::domains_type(domains_.begin(), domains_.end());
-                    minf.paths = paths_;
-                    switch(type) {
-                        case char_facet_t::nochar: break;
-                        case char_facet_t::char_f:
-                            return std::locale(base, gnu_gettext::create_messages_facet<char>(minf));
-                        case char_facet_t::wchar_f:
-                            return std::locale(base, gnu_gettext::create_messages_facet<wchar_t>(minf));
-#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
-                        case char_facet_t::char16_f:
-                            return std::locale(base, gnu_gettext::create_messages_facet<char16_t>(minf));
-#endif
-#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
-                        case char_facet_t::char32_f:
-                            return std::locale(base, gnu_gettext::create_messages_facet<char32_t>(minf));
-#endif
-                    }
-                    return base;
-                }
+                case category_t::message: return create_messages(base, messages_info(), type);
                 case category_t::boundary: return create_boundary(base, data_, type);
                 case category_t::calendar: return create_calendar(base, data_);
                 case category_t::information: return util::create_info(base, real_id_);
@@ -111,7 +137,73 @@ namespace boost { namespace locale { namespace impl_icu {
             return base;
         }
 
+        std::locale install_all(const std::locale& base, category_t categories, char_facet_t types) override
+        {
+            const category_t numeric = category_t::formatting | category_t::parsing;
+            if(!(categories & category_t::formatting) || !(categories & category_t::parsing))
+                return localization_backend::install_all(base, categories, types);
+            prepare_data();
+            // Formatting and parsing share the formatters cache, so install them together.
+            // None of those facets is installed by another category so the order doesn't matter.
+            std::locale result = base;
+            for(char_facet_t ch = character_facet_first; ch <= character_facet_last; ++ch) {
+                if(ch & types)
+                    result = create_formatting_and_parsing(result, data_, ch);
+            }
+            return localization_backend::install_all(result, categories ^ numeric, types);
+        }
+
     private:
+        gnu_gettext::messages_info messages_info() const
+        {
+            gnu_gettext::messages_info minf;
+            minf.language = language_;
+            minf.country = country_;
+            minf.variant = variant_;
+            minf.encoding = data_.encoding;
+            minf.domains = gnu_gettext::messages_info::domains_type(domains_.begin(), domains_.end());
+            minf.paths = paths_;
+            return minf;
+        }
+
+        static std::locale
+        create_messages(const std::locale& base, const gnu_gettext::messages_info& minf, char_facet_t type)
+        {
+            switch(type) {
+                case char_facet_t::nochar: break;
+                case char_facet_t::char_f: return std::locale(base, gnu_gettext::create_messages_facet<char>(minf));
+                case char_facet_t::wchar_f:
+                    return std::locale(base, gnu_gettext::create_messages_facet<wchar_t>(minf));
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+                case char_facet_t::char16_f:
+                    return std::locale(base, gnu_gettext::create_messages_facet<char16_t>(minf));
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+                case char_facet_t::char32_f:
+                    return std::locale(base, gnu_gettext::create_messages_facet<char32_t>(minf));
+#endif
+            }
+            return base;
+        }
+
+        template<template<typename> class LazyFacet>
+        static std::locale
+        install_lazy(const std::locale& base, char_facet_t type, std::function<std::locale()> factory)
+        {
+            switch(type) {
+                case char_facet_t::nochar: break;
+                case char_facet_t::char_f: return std::locale(base, new LazyFacet<char>(std::move(factory)));
+                case char_facet_t::wchar_f: return std::locale(base, new LazyFacet<wchar_t>(std::move(factory)));
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+                case char_facet_t::char16_f: return std::locale(base, new LazyFacet<char16_t>(std::move(factory)));
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+                case char_facet_t::char32_f: return std::locale(base, new LazyFacet<char32_t>(std::move(factory)));
+#endif
+            }
+            return base;
+        }
+
         std::vector<std::string> paths_;
         std::vector<std::string> domains_;
         std::string locale_id_;
@@ -121,12 +213,15 @@ namespace boost { namespace locale { namespace impl_icu {
         std::string country_;
         std::string variant_;
         std::string real_id_;
+        bool c_locale_;
         bool invalid_;
         bool use_ansi_encoding_;
+        bool lazy_facets_;
     };
 
     std::unique_ptr<localization_backend> create_localization_backend()
     {
+        init_icu_data();
         return make_std_unique<icu_localization_backend>();
     }
 
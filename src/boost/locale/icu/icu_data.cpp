@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "boost/locale/icu/icu_data.hpp"
+#include "boost/locale/icu/icu_util.hpp"
+#include <boost/core/ignore_unused.hpp>
+#include <unicode/udata.h>
+#include <unicode/ures.h>
+
+namespace boost { namespace locale { namespace impl_icu {
+
+#ifdef BOOST_LOCALE_ICU_EMBEDDED_DATA
+    // Defined in the source generated from the data file by the build
+    extern const unsigned char embedded_icu_data[];
+#endif
+
+    void init_icu_data()
+    {
+#ifdef BOOST_LOCALE_ICU_EMBEDDED_DATA
+        static const bool registered = []() {
+            UErrorCode err = U_ZERO_ERROR;
+            udata_setCommonData(embedded_icu_data, &err);
+            check_and_throw_icu_error(err, "Registering the embedded ICU data failed");
+            return true;
+        }();
+        boost::ignore_unused(registered);
+#endif
+    }
+
+    bool has_locale_data(const icu::Locale& locale)
+    {
+        UErrorCode err = U_ZERO_ERROR;
+        UResourceBundle* bundle = ures_open(nullptr, locale.getName(), &err);
+        if(bundle)
+            ures_close(bundle);
+        return U_SUCCESS(err) && err != U_USING_DEFAULT_WARNING;
+    }
+
+}}} // namespace boost::locale::impl_icu
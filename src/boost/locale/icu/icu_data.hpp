@@ -0,0 +1,25 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_IMPL_ICU_DATA_HPP
+#define BOOST_LOCALE_IMPL_ICU_DATA_HPP
+
+#include <boost/locale/config.hpp>
+#include <unicode/locid.h>
+
+namespace boost { namespace locale { namespace impl_icu {
+
+    /// Register the ICU data embedded into the library, if it was built with \c BOOST_LOCALE_ICU_DATA
+    ///
+    /// Must be called before ICU loads any data to have an effect. Calling it multiple times is fine.
+    void init_icu_data();
+
+    /// Check if the ICU data has locale specific data for \a locale instead of only the root locale
+    bool has_locale_data(const icu::Locale& locale);
+
+}}} // namespace boost::locale::impl_icu
+
+#endif
@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "boost/locale/icu/number_profile.hpp"
+#include "boost/locale/icu/icu_util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#ifdef BOOST_MSVC
+#    pragma warning(push)
+#    pragma warning(disable : 4251) // "identifier" : class "type" needs to have dll-interface...
+#endif
+#include <unicode/dcfmtsym.h>
+#include <unicode/decimfmt.h>
+#ifdef BOOST_MSVC
+#    pragma warning(pop)
+#endif
+
+namespace boost { namespace locale { namespace impl_icu {
+
+    namespace {
+        number_profile::symbol make_symbol(const icu::UnicodeString& str)
+        {
+            return number_profile::symbol{str, static_cast<size_t>(str.countChar32())};
+        }
+
+        template<size_t N>
+        bool verify_doubles(const number_profile& profile, const icu::NumberFormat& fmt, const double (&values)[N])
+        {
+            for(const double value : values) {
+                if(!profile.can_format(value))
+                    continue;
+                icu::UnicodeString expected, actual;
+                fmt.format(value, expected);
+                if(profile.format(actual, value) != static_cast<size_t>(expected.countChar32()) || actual != expected)
+                    return false;
+            }
+            return true;
+        }
+
+        // Compare the output of the profile with the one of ICU for values covering all code paths
+        bool verify_profile(const number_profile& profile, const icu::NumberFormat& fmt)
+        {
+            const int64_t values[] = {0,
+                                      7,
+                                      -7,
+                                      42,
+                                      123,
+                                      -1234,
+                                      12345,
+                                      123456,
+                                      -1234567,
+                                      12345678,
+                                      1234567890123456789,
+                                      std::numeric_limits<int64_t>::max(),
+                                      std::numeric_limits<int64_t>::min()};
+            for(const int64_t value : values) {
+                icu::UnicodeString expected, actual;
+                fmt.format(value, expected);
+                if(profile.format(actual, value) != static_cast<size_t>(expected.countChar32()) || actual != expected)
+                    return false;
+            }
+            const double double_values[] = {1.0, -1000.0, 9007199254740992.0};
+            return verify_doubles(profile, fmt, double_values);
+        }
+
+        // Same as verify_profile for non-integral values, which are rounded and have their trailing zeros removed
+        bool verify_fractional(const number_profile& profile, const icu::NumberFormat& fmt)
+        {
+            const double values[] = {0.25,
+                                     -0.75,
+                                     3.14159265,
+                                     -1234.5678,
+                                     1234567.891,
+                                     0.001,
+                                     12.05,
+                                     100.0001,
+                                     2.675,
+                                     -9876.125,
+                                     0.1 + 0.2,
+                                     123456789.0123456,
+                                     1e-7,
+                                     0.9999,
+                                     -1.0 / 3};
+            return verify_doubles(profile, fmt, values);
+        }
+
+        /// Get \a sym as a single ASCII character which can't be confused with other parts of a number or 0
+        char get_ascii_separator(const number_profile::symbol& sym)
+        {
+            if(sym.str.length() != 1)
+                return 0;
+            const UChar c = sym.str[0];
+            if(c <= 0x20 || c >= 0x7F || (c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e' || c == 'E')
+                return 0;
+            return static_cast<char>(c);
+        }
+
+        template<typename ValueType>
+        bool same_value(ValueType a, ValueType b)
+        {
+            return a == b;
+        }
+        bool same_value(double a, double b)
+        {
+            return a == b && std::signbit(a) == std::signbit(b);
+        }
+
+        /// Check that ICU parses \a str the same if the profile can parse it
+        template<typename ValueType>
+        bool verify_parse(const number_profile& profile, const icu::NumberFormat& fmt, const icu::UnicodeString& str)
+        {
+            ValueType actual;
+            const size_t len = profile.parse(str.getBuffer(), str.getBuffer() + str.length(), actual);
+            if(len == 0)
+                return true;
+            icu::Formattable parsed;
+            icu::ParsePosition pp;
+            fmt.parse(str, parsed, pp);
+            UErrorCode err = U_ZERO_ERROR;
+            const ValueType expected = static_cast<ValueType>(parsed.getDouble(err));
+            return U_SUCCESS(err) && static_cast<size_t>(pp.getIndex()) == len && same_value(actual, expected);
+        }
+
+        bool verify_parsing(const number_profile& profile, const icu::NumberFormat& fmt)
+        {
+            const icu::UnicodeString dec = profile.decimal_separator.str;
+            const char* const plain[] = {"0",     "7",    "-7",    "0012",  "-0",    "12 ",    "12 x",
+                                         "12 -3", "12 \t", "12  34", "12 e5", "-12 x", "123456789012345"};
+            const char* const fractional[] = {"-3", "25", "0", "000001", "1234567", "89 z", "5\t"};
+            std::vector<icu::UnicodeString> inputs;
+            for(const char* str : plain)
+                inputs.push_back(icu::UnicodeString(str, -1, US_INV));
+            for(size_t i = 0; i + 1 < sizeof(fractional) / sizeof(fractional[0]); i++)
+                inputs.push_back(icu::UnicodeString(fractional[i], -1, US_INV) + dec
+                                 + icu::UnicodeString(fractional[i + 1], -1, US_INV));
+            const int64_t grouped[] = {1234, -1234567, 123456789, 100000};
+            for(const int64_t value : grouped) {
+                icu::UnicodeString str;
+                profile.format(str, value);
+                inputs.push_back(str);
+                inputs.push_back(str + " x");
+            }
+            for(const icu::UnicodeString& str : inputs) {
+                if(!verify_parse<double>(profile, fmt, str) || !verify_parse<int64_t>(profile, fmt, str))
+                    return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    std::unique_ptr<number_profile> create_number_profile(const icu::NumberFormat& fmt)
+    {
+        const icu::DecimalFormat* dfmt = icu_cast<const icu::DecimalFormat>(&fmt);
+        if(!dfmt)
+            return nullptr;
+        if(dfmt->isScientificNotation() || dfmt->areSignificantDigitsUsed() || dfmt->getMultiplier() != 1
+           || dfmt->getRoundingIncrement() != 0 || dfmt->getFormatWidth() > 0 || dfmt->getMinimumIntegerDigits() != 1
+           || dfmt->isDecimalSeparatorAlwaysShown())
+            return nullptr;
+
+        std::unique_ptr<number_profile> profile(new number_profile());
+        const icu::DecimalFormatSymbols* symbols = dfmt->getDecimalFormatSymbols();
+        if(!symbols)
+            return nullptr; // LCOV_EXCL_LINE
+        const icu::UnicodeString zero = symbols->getSymbol(icu::DecimalFormatSymbols::kZeroDigitSymbol);
+        if(zero.countChar32() != 1)
+            return nullptr; // LCOV_EXCL_LINE
+        for(int i = 0; i < 10; i++)
+            profile->digits[i] = make_symbol(icu::UnicodeString(static_cast<UChar32>(zero.char32At(0) + i)));
+        profile->decimal_separator =
+          make_symbol(symbols->getSymbol(icu::DecimalFormatSymbols::kDecimalSeparatorSymbol));
+        profile->grouping_separator =
+          make_symbol(symbols->getSymbol(icu::DecimalFormatSymbols::kGroupingSeparatorSymbol));
+
+        icu::UnicodeString affix;
+        profile->positive_prefix = make_symbol(dfmt->getPositivePrefix(affix));
+        profile->positive_suffix = make_symbol(dfmt->getPositiveSuffix(affix));
+        profile->negative_prefix = make_symbol(dfmt->getNegativePrefix(affix));
+        profile->negative_suffix = make_symbol(dfmt->getNegativeSuffix(affix));
+
+        profile->grouping_size = dfmt->isGroupingUsed() ? dfmt->getGroupingSize() : 0;
+        if(profile->grouping_size < 0)
+            profile->grouping_size = 0;
+        profile->secondary_grouping_size = dfmt->getSecondaryGroupingSize();
+        if(profile->secondary_grouping_size < 1)
+            profile->secondary_grouping_size = profile->grouping_size;
+#if BOOST_LOCALE_ICU_VERSION >= 6400
+        profile->min_grouping_digits = std::max(dfmt->getMinimumGroupingDigits(), 1);
+#else
+        profile->min_grouping_digits = 1;
+#endif
+        profile->fraction_digits = dfmt->getMinimumFractionDigits();
+        // Only rounding to the nearest value yields the same result for the exact and the shortest representation
+        const icu::DecimalFormat::ERoundingMode rounding = dfmt->getRoundingMode();
+        const bool round_to_nearest = rounding == icu::DecimalFormat::kRoundHalfEven
+                                      || rounding == icu::DecimalFormat::kRoundHalfDown
+                                      || rounding == icu::DecimalFormat::kRoundHalfUp;
+        profile->max_fraction_digits = dfmt->getMaximumFractionDigits();
+        if(!round_to_nearest || profile->max_fraction_digits > 15
+           || profile->max_fraction_digits < profile->fraction_digits)
+            profile->max_fraction_digits = -1;
+
+        if(!verify_profile(*profile, fmt))
+            return nullptr;
+        if(profile->max_fraction_digits >= 0 && !verify_fractional(*profile, fmt))
+            profile->max_fraction_digits = -1;
+
+        bool ascii_digits = true;
+        for(int i = 0; i < 10; i++)
+            ascii_digits &= profile->digits[i].str == icu::UnicodeString(static_cast<UChar>('0' + i));
+        profile->ascii_decimal_separator = get_ascii_separator(profile->decimal_separator);
+        profile->ascii_grouping_separator = get_ascii_separator(profile->grouping_separator);
+        profile->ascii_parsing = ascii_digits && profile->ascii_decimal_separator != 0
+                                 && profile->ascii_grouping_separator != 0
+                                 && profile->ascii_decimal_separator != profile->ascii_grouping_separator
+                                 && profile->positive_prefix.str.isEmpty() && profile->positive_suffix.str.isEmpty();
+        profile->ascii_negative = profile->negative_prefix.str == icu::UnicodeString(static_cast<UChar>('-'))
+                                  && profile->negative_suffix.str.isEmpty();
+        if(profile->ascii_parsing && !verify_parsing(*profile, fmt))
+            profile->ascii_parsing = false;
+        return profile;
+    }
+
+}}} // namespace boost::locale::impl_icu
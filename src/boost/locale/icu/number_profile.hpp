@@ -0,0 +1,309 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_IMPL_ICU_NUMBER_PROFILE_HPP
+#define BOOST_LOCALE_IMPL_ICU_NUMBER_PROFILE_HPP
+
+#include <boost/locale/config.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#ifdef BOOST_MSVC
+#    pragma warning(push)
+#    pragma warning(disable : 4251) // "identifier" : class "type" needs to have dll-interface...
+#endif
+#include <unicode/numfmt.h>
+#include <unicode/unistr.h>
+#ifdef BOOST_MSVC
+#    pragma warning(pop)
+#endif
+
+namespace boost { namespace locale { namespace impl_icu {
+
+    /// The symbols and rules an ICU number format uses to write numbers.
+    ///
+    /// Allows to write integral values and fractional values not close to a rounding boundary without going
+    /// through ICU while producing the same output and to parse simple numbers written with ASCII digits.
+    template<typename StringType>
+    struct basic_number_profile {
+        /// A string with its length in code points
+        struct symbol {
+            StringType str;
+            size_t code_points;
+        };
+
+        symbol digits[10];
+        symbol decimal_separator, grouping_separator;
+        symbol positive_prefix, positive_suffix, negative_prefix, negative_suffix;
+        int grouping_size;           ///< Zero if no grouping is used
+        int secondary_grouping_size; ///< Size of all groups but the first one
+        int min_grouping_digits;     ///< Only group if there are at least this many digits in front of the first group
+        int fraction_digits;         ///< Minimum number of digits written after the decimal separator
+        int max_fraction_digits;     ///< Digits non-integral values are rounded to, -1 if those aren't supported
+        bool ascii_parsing;          ///< Digits and separators are ASCII and parse() may be used
+        bool ascii_negative;         ///< Negative values are written with a leading '-' only
+
+        /// Check if the value can be written using this profile
+        bool can_format(double value) const
+        {
+            // Integers exactly representable in a double and not the negative zero
+            if(value == std::floor(value))
+                return std::fabs(value) <= 9007199254740992.0 && !(value == 0 && std::signbit(value));
+            if(max_fraction_digits < 0)
+                return false;
+            // ICU rounds the shortest decimal representation of the value, not its exact binary one,
+            // which only makes a difference close to a tie. Also exclude values which are rounded to zero
+            // as ICU writes negative ones with the sign.
+            const double scaled = std::fabs(value) * power_of_ten(max_fraction_digits);
+            if(!(scaled >= 1 && scaled < 1e15))
+                return false;
+            return std::fabs(scaled - std::floor(scaled) - 0.5) > scaled * 1e-13;
+        }
+        bool can_format(int64_t) const { return true; }
+        bool can_format(int32_t) const { return true; }
+
+        /// Append the \a value to \a out and return the number of code points written.
+        /// Requires can_format(value)
+        size_t format(StringType& out, double value) const
+        {
+            if(value == std::floor(value))
+                return format(out, static_cast<int64_t>(value));
+            const double scaled = std::floor(std::fabs(value) * power_of_ten(max_fraction_digits) + 0.5);
+            const uint64_t divisor = static_cast<uint64_t>(power_of_ten(max_fraction_digits));
+            const uint64_t rounded = static_cast<uint64_t>(scaled);
+            uint64_t fraction = rounded % divisor;
+            int num_fraction_digits = max_fraction_digits;
+            // Trailing zeros are only written up to the minimum number of fraction digits
+            while(num_fraction_digits > fraction_digits && fraction % 10 == 0) {
+                fraction /= 10;
+                --num_fraction_digits;
+            }
+            return format_digits(out, value < 0, rounded / divisor, fraction, num_fraction_digits);
+        }
+        size_t format(StringType& out, int32_t value) const { return format(out, static_cast<int64_t>(value)); }
+        size_t format(StringType& out, int64_t value) const
+        {
+            const bool negative = value < 0;
+            // Avoid overflow for the minimum value
+            const uint64_t abs_value =
+              negative ? static_cast<uint64_t>(-(value + 1)) + 1u : static_cast<uint64_t>(value);
+            return format_digits(out, negative, abs_value, 0, fraction_digits);
+        }
+
+        /// Parse a number at the start of [\a begin, \a end) consisting of ASCII digits, an optional leading '-',
+        /// grouping separators at their regular positions and an optional decimal separator followed by digits.
+        /// The number must be followed by the end of the input or a space or tab which is not followed by
+        /// a digit or separator, as ICU could treat the space as a grouping separator.
+        ///
+        /// Returns the number of characters parsed or zero if the input is not such a number
+        /// or the value can't be converted exactly, in which case ICU needs to be used.
+        template<typename CharType>
+        size_t parse(const CharType* begin, const CharType* end, double& value) const
+        {
+            parsed_number num;
+            const size_t len = parse_number(begin, end, 15, num);
+            if(len == 0)
+                return 0;
+            // Both values are exactly representable so the division is correctly rounded
+            const double abs_value = static_cast<double>(num.digits) / power_of_ten(num.fraction_digits);
+            value = num.negative ? -abs_value : abs_value;
+            return len;
+        }
+        template<typename CharType>
+        size_t parse(const CharType* begin, const CharType* end, int64_t& value) const
+        {
+            parsed_number num;
+            const size_t len = parse_number(begin, end, 18, num);
+            if(len == 0 || num.fraction_digits != 0)
+                return 0;
+            value = num.negative ? -static_cast<int64_t>(num.digits) : static_cast<int64_t>(num.digits);
+            return len;
+        }
+        template<typename CharType>
+        size_t parse(const CharType* begin, const CharType* end, int32_t& value) const
+        {
+            int64_t tmp;
+            const size_t len = parse(begin, end, tmp);
+            if(len == 0 || tmp < std::numeric_limits<int32_t>::min() || tmp > std::numeric_limits<int32_t>::max())
+                return 0;
+            value = static_cast<int32_t>(tmp);
+            return len;
+        }
+
+        /// Create a profile for another string type by converting all symbols with \a cvt
+        template<typename OtherString, typename Converter>
+        basic_number_profile<OtherString> convert(const Converter& cvt) const
+        {
+            basic_number_profile<OtherString> result;
+            const auto convert_symbol = [&cvt](const symbol& s) {
+                return typename basic_number_profile<OtherString>::symbol{cvt(s.str), s.code_points};
+            };
+            for(int i = 0; i < 10; i++)
+                result.digits[i] = convert_symbol(digits[i]);
+            result.decimal_separator = convert_symbol(decimal_separator);
+            result.grouping_separator = convert_symbol(grouping_separator);
+            result.positive_prefix = convert_symbol(positive_prefix);
+            result.positive_suffix = convert_symbol(positive_suffix);
+            result.negative_prefix = convert_symbol(negative_prefix);
+            result.negative_suffix = convert_symbol(negative_suffix);
+            result.grouping_size = grouping_size;
+            result.secondary_grouping_size = secondary_grouping_size;
+            result.min_grouping_digits = min_grouping_digits;
+            result.fraction_digits = fraction_digits;
+            result.max_fraction_digits = max_fraction_digits;
+            result.ascii_parsing = ascii_parsing;
+            result.ascii_negative = ascii_negative;
+            result.ascii_decimal_separator = ascii_decimal_separator;
+            result.ascii_grouping_separator = ascii_grouping_separator;
+            return result;
+        }
+
+        char ascii_decimal_separator, ascii_grouping_separator; ///< Only valid if ascii_parsing is set
+
+    private:
+        struct parsed_number {
+            uint64_t digits; ///< All digits without separators
+            int fraction_digits;
+            bool negative;
+        };
+
+        static bool is_digit(const unsigned c) { return c >= '0' && c <= '9'; }
+
+        /// Exact power of ten for \a exponent in [0, 15]
+        static double power_of_ten(const int exponent)
+        {
+            static const double powers_of_ten[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                   1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+            return powers_of_ten[exponent];
+        }
+
+        /// Write the number with the integral part \a abs_value and the \a fraction
+        /// which is written with \a num_fraction_digits digits
+        size_t format_digits(StringType& out,
+                             const bool negative,
+                             uint64_t abs_value,
+                             uint64_t fraction,
+                             const int num_fraction_digits) const
+        {
+            char buf[20];
+            int num_digits = 0;
+            do {
+                buf[num_digits++] = static_cast<char>(abs_value % 10);
+                abs_value /= 10;
+            } while(abs_value != 0);
+
+            const symbol& prefix = negative ? negative_prefix : positive_prefix;
+            const symbol& suffix = negative ? negative_suffix : positive_suffix;
+            size_t code_points = prefix.code_points + suffix.code_points;
+            out += prefix.str;
+            const bool use_grouping = grouping_size > 0 && num_digits >= grouping_size + min_grouping_digits;
+            for(int i = num_digits - 1; i >= 0; i--) {
+                const symbol& digit = digits[static_cast<int>(buf[i])];
+                out += digit.str;
+                code_points += digit.code_points;
+                if(use_grouping && is_group_end(i)) {
+                    out += grouping_separator.str;
+                    code_points += grouping_separator.code_points;
+                }
+            }
+            if(num_fraction_digits > 0) {
+                out += decimal_separator.str;
+                code_points += decimal_separator.code_points;
+                for(int i = num_fraction_digits - 1; i >= 0; i--) {
+                    // The fraction has at most 15 digits but integers may be written with more zeros
+                    const uint64_t digit_value = i < 15 ? fraction / static_cast<uint64_t>(power_of_ten(i)) % 10 : 0;
+                    const symbol& digit = digits[static_cast<int>(digit_value)];
+                    out += digit.str;
+                    code_points += digit.code_points;
+                }
+            }
+            out += suffix.str;
+            return code_points;
+        }
+
+        /// Parse the number as described in parse() with at most \a max_digits digits
+        template<typename CharType>
+        size_t parse_number(const CharType* begin, const CharType* end, int max_digits, parsed_number& num) const
+        {
+            if(!ascii_parsing)
+                return 0;
+            const CharType* p = begin;
+            num.negative = p != end && *p == '-';
+            if(num.negative) {
+                if(!ascii_negative)
+                    return 0;
+                ++p;
+            }
+            num.digits = 0;
+            num.fraction_digits = 0;
+            int num_digits = 0;
+            // Number of digits since the last grouping separator and the number of separators
+            int group_digits = 0, num_groups = 0;
+            for(; p != end; ++p) {
+                const unsigned c = static_cast<unsigned>(*p);
+                if(is_digit(c)) {
+                    if(++num_digits > max_digits)
+                        return 0;
+                    num.digits = num.digits * 10 + (c - '0');
+                    ++group_digits;
+                } else if(c == static_cast<unsigned char>(ascii_grouping_separator)) {
+                    // Only the first group may be shorter, ICU rejects other positions
+                    if(grouping_size == 0 || min_grouping_digits != 1 || group_digits == 0
+                       || group_digits > secondary_grouping_size
+                       || (num_groups > 0 && group_digits != secondary_grouping_size))
+                        return 0;
+                    ++num_groups;
+                    group_digits = 0;
+                } else
+                    break;
+            }
+            if(group_digits == 0 || (num_groups > 0 && group_digits != grouping_size))
+                return 0;
+            if(p != end && static_cast<unsigned>(*p) == static_cast<unsigned char>(ascii_decimal_separator)) {
+                for(++p; p != end && is_digit(static_cast<unsigned>(*p)); ++p) {
+                    if(++num_digits > max_digits)
+                        return 0;
+                    num.digits = num.digits * 10 + (static_cast<unsigned>(*p) - '0');
+                    ++num.fraction_digits;
+                }
+                if(num.fraction_digits == 0)
+                    return 0;
+            }
+            if(p != end) {
+                if(*p != ' ' && *p != '\t')
+                    return 0;
+                const CharType* next = p + 1;
+                if(next != end) {
+                    const unsigned c = static_cast<unsigned>(*next);
+                    if(is_digit(c) || c == static_cast<unsigned char>(ascii_decimal_separator)
+                       || c == static_cast<unsigned char>(ascii_grouping_separator) || c == '.' || c == ','
+                       || c == '\'' || c >= 0x80)
+                        return 0;
+                }
+            }
+            return static_cast<size_t>(p - begin);
+        }
+
+        /// Check if a separator follows the digit at position \a i (counted from the right starting at zero)
+        bool is_group_end(const int i) const
+        {
+            if(i == grouping_size)
+                return true;
+            return i > grouping_size && (i - grouping_size) % secondary_grouping_size == 0;
+        }
+    };
+
+    typedef basic_number_profile<icu::UnicodeString> number_profile;
+
+    /// Get the profile of the number format \a fmt, or null if it uses features the profile doesn't support.
+    /// The profile is verified to produce the same output as \a fmt for a couple of values.
+    std::unique_ptr<number_profile> create_number_profile(const icu::NumberFormat& fmt);
+
+}}} // namespace boost::locale::impl_icu
+
+#endif
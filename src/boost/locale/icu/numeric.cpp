@@ -107,7 +107,7 @@ namespace boost { namespace locale { namespace impl_icu {
             if(detail::use_parent(ios, val))
                 return std::num_put<CharType>::do_put(out, ios, fill, val);
 
-            const auto formatter = formatter_type::create(ios, loc_, enc_);
+            const formatter_type* formatter = formatter_type::get(ios, loc_, enc_);
 
             if(!formatter)
                 return std::num_put<CharType>::do_put(out, ios, fill, val);
@@ -240,7 +240,7 @@ namespace boost { namespace locale { namespace impl_icu {
             if(!stream_ptr || detail::use_parent(ios, ValueType(0)))
                 return std::num_get<CharType>::do_get(in, end, ios, err, val);
 
-            const auto formatter = formatter_type::create(ios, loc_, enc_);
+            const formatter_type* formatter = formatter_type::get(ios, loc_, enc_);
             if(!formatter)
                 return std::num_get<CharType>::do_get(in, end, ios, err, val);
 
@@ -320,6 +320,16 @@ namespace boost { namespace locale { namespace impl_icu {
         return tmp;
     }
 
+    template<typename CharType>
+    std::locale install_formatting_and_parsing_facets(const std::locale& in, const cdata& cd)
+    {
+        std::locale tmp = std::locale(in, new num_format<CharType>(cd));
+        tmp = std::locale(tmp, new num_parse<CharType>(cd));
+        if(!std::has_facet<formatters_cache>(in))
+            tmp = std::locale(tmp, new formatters_cache(cd.locale));
+        return tmp;
+    }
+
     std::locale create_formatting(const std::locale& in, const cdata& cd, char_facet_t type)
     {
         switch(type) {
@@ -352,6 +362,22 @@ namespace boost { namespace locale { namespace impl_icu {
         return in;
     }
 
+    std::locale create_formatting_and_parsing(const std::locale& in, const cdata& cd, char_facet_t type)
+    {
+        switch(type) {
+            case char_facet_t::nochar: break;
+            case char_facet_t::char_f: return install_formatting_and_parsing_facets<char>(in, cd);
+            case char_facet_t::wchar_f: return install_formatting_and_parsing_facets<wchar_t>(in, cd);
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+            case char_facet_t::char16_f: return install_formatting_and_parsing_facets<char16_t>(in, cd);
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+            case char_facet_t::char32_f: return install_formatting_and_parsing_facets<char32_t>(in, cd);
+#endif
+        }
+        return in;
+    }
+
 }}} // namespace boost::locale::impl_icu
 
 // boostinspect:nominmax
@@ -8,6 +8,9 @@
 #include <boost/locale/hold_ptr.hpp>
 #include "boost/locale/icu/icu_util.hpp"
 #include <boost/predef/os.h>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <memory>
 
 //
 // Bug - when ICU tries to find a file that is equivalent to /etc/localtime it finds /usr/share/zoneinfo/localtime
@@ -30,7 +33,6 @@
 #    include <cstring>
 #    include <dirent.h>
 #    include <fstream>
-#    include <memory>
 #    include <pthread.h>
 #    include <sys/stat.h>
 #    include <sys/types.h>
@@ -39,6 +41,35 @@
 
 namespace boost { namespace locale { namespace impl_icu {
 
+    namespace {
+        // Creating a time zone from its ID loads and parses the zone data each time.
+        // So keep one unmodified instance per ID and return copies of it.
+        icu::TimeZone* get_named_time_zone(const std::string& time_zone)
+        {
+            // Bounds the memory used by applications using many (custom) zones, further ones are created each time
+            constexpr size_t max_cached_zones = 64;
+            static boost::mutex lock;
+            static std::map<std::string, std::unique_ptr<const icu::TimeZone>> zones;
+
+            {
+                boost::unique_lock<boost::mutex> guard(lock);
+                const auto it = zones.find(time_zone);
+                if(it != zones.end())
+                    return it->second->clone();
+            }
+            std::unique_ptr<icu::TimeZone> zone(icu::TimeZone::createTimeZone(time_zone.c_str()));
+            // Unrecognized IDs yield the unknown zone, don't let arbitrary input fill the cache with it
+            icu::UnicodeString id;
+            if(zone->getID(id) == icu::UnicodeString("Etc/Unknown", -1, US_INV))
+                return zone.release();
+            std::unique_ptr<const icu::TimeZone> cached(zone->clone());
+            boost::unique_lock<boost::mutex> guard(lock);
+            if(zones.size() < max_cached_zones)
+                zones.emplace(time_zone, std::move(cached));
+            return zone.release();
+        }
+    } // namespace
+
 #ifndef BOOST_LOCALE_WORKAROUND_ICU_BUG
 
     // This is normal behavior
@@ -48,7 +79,7 @@ namespace boost { namespace locale { namespace impl_icu {
         if(time_zone.empty())
             return icu::TimeZone::createDefault();
         else
-            return icu::TimeZone::createTimeZone(time_zone.c_str());
+            return get_named_time_zone(time_zone);
     }
 
 #else
@@ -191,7 +222,7 @@ namespace boost { namespace locale { namespace impl_icu {
     icu::TimeZone* get_time_zone(const std::string& time_zone)
     {
         if(!time_zone.empty())
-            return icu::TimeZone::createTimeZone(time_zone.c_str());
+            return get_named_time_zone(time_zone);
         hold_ptr<icu::TimeZone> tz(icu::TimeZone::createDefault());
         icu::UnicodeString id;
         tz->getID(id);
@@ -205,7 +236,7 @@ namespace boost { namespace locale { namespace impl_icu {
             // if we failed fallback to ICU's time zone
             return tz.release();
         }
-        return icu::TimeZone::createTimeZone(real_id.c_str());
+        return get_named_time_zone(real_id);
     }
 #endif // bug workaround
 
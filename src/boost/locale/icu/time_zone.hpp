@@ -16,7 +16,8 @@ namespace boost { namespace locale { namespace impl_icu {
 
     // Provides a workaround for an ICU default timezone bug and also
     // handles time_zone string correctly - if empty returns default
-    // otherwise returns the instance created with time_zone
+    // otherwise returns the instance created with time_zone.
+    // Named time zones known to ICU are created only once (up to a limit) and copied afterwards.
     icu::TimeZone* get_time_zone(const std::string& time_zone);
 }}} // namespace boost::locale::impl_icu
 #endif
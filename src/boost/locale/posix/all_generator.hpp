@@ -25,6 +25,10 @@ namespace boost { namespace locale { namespace impl_posix {
     std::locale create_formatting(const std::locale& in, std::shared_ptr<locale_t> lc, char_facet_t type);
 
     std::locale create_parsing(const std::locale& in, std::shared_ptr<locale_t> lc, char_facet_t type);
+    /// Same as create_formatting followed by create_parsing but without installing shared facets twice
+    std::locale
+    create_formatting_and_parsing(const std::locale& in, std::shared_ptr<locale_t> lc, char_facet_t type);
+
     std::locale create_codecvt(const std::locale& in, const std::string& encoding, char_facet_t type);
 
 }}} // namespace boost::locale::impl_posix
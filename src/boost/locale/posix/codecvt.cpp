@@ -15,7 +15,7 @@ namespace boost { namespace locale { namespace impl_posix {
 
     std::locale create_codecvt(const std::locale& in, const std::string& encoding, char_facet_t type)
     {
-        if(util::normalize_encoding(encoding) == "utf8")
+        if(util::utf8_only || util::is_utf8_encoding(encoding))
             return util::create_utf8_codecvt(in, type);
 
         try {
@@ -116,7 +116,7 @@ namespace boost { namespace locale { namespace impl_posix {
         switch(type) {
             case char_facet_t::nochar: break;
             case char_facet_t::char_f: {
-                if(util::normalize_encoding(nl_langinfo_l(CODESET, *lc)) == "utf8")
+                if(util::utf8_only || util::is_utf8_encoding(nl_langinfo_l(CODESET, *lc)))
                     return std::locale(in, new utf8_converter(std::move(lc)));
                 return std::locale(in, new std_converter<char>(std::move(lc)));
             }
@@ -431,4 +431,28 @@ namespace boost { namespace locale { namespace impl_posix {
         return in;
     }
 
+    template<typename CharType>
+    std::locale create_formatting_and_parsing_impl(const std::locale& in, std::shared_ptr<locale_t> lc)
+    {
+        // The formatting facets include the numpunct and ctype facets required for parsing
+        const std::locale tmp = create_formatting_impl<CharType>(in, std::move(lc));
+        return std::locale(tmp, new util::base_num_parse<CharType>());
+    }
+
+    std::locale create_formatting_and_parsing(const std::locale& in, std::shared_ptr<locale_t> lc, char_facet_t type)
+    {
+        switch(type) {
+            case char_facet_t::nochar: break;
+            case char_facet_t::char_f: return create_formatting_and_parsing_impl<char>(in, std::move(lc));
+            case char_facet_t::wchar_f: return create_formatting_and_parsing_impl<wchar_t>(in, std::move(lc));
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+            case char_facet_t::char16_f: return create_formatting_and_parsing_impl<char16_t>(in, lc);
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+            case char_facet_t::char32_f: return create_formatting_and_parsing_impl<char32_t>(in, lc);
+#endif
+        }
+        return in;
+    }
+
 }}} // namespace boost::locale::impl_posix
@@ -11,15 +11,20 @@
 #include <boost/locale/localization_backend.hpp>
 #include <boost/locale/util.hpp>
 #include <boost/locale/util/locale_data.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <algorithm>
 #include <iterator>
 #include <langinfo.h>
+#include <unordered_map>
 #include <vector>
 #if defined(__FreeBSD__)
 #    include <xlocale.h>
 #endif
 
 #include "boost/locale/posix/all_generator.hpp"
+#include "boost/locale/util/c_locale_facets.hpp"
+#include "boost/locale/util/encoding.hpp"
 #include "boost/locale/util/gregorian.hpp"
 #include "boost/locale/util/make_std_unique.hpp"
 
@@ -58,6 +63,43 @@ namespace boost { namespace locale { namespace impl_posix {
             delete lc;
         }
 
+        /// Get the handle for the locale \a name or NULL if it doesn't exist.
+        ///
+        /// Creating them is expensive, so the handles and missing names are shared by all backends in the process
+        static std::shared_ptr<locale_t> get_locale(const std::string& name)
+        {
+            // Bounds the memory used when many different names are requested, further ones are created each time
+            constexpr size_t max_cached_locales = 64;
+            static boost::mutex lock;
+            static std::unordered_map<std::string, std::shared_ptr<locale_t>> locales;
+
+            {
+                boost::unique_lock<boost::mutex> guard(lock);
+                const auto it = locales.find(name);
+                if(it != locales.end())
+                    return it->second;
+            }
+
+            std::shared_ptr<locale_t> lc;
+            locale_t tmp = newlocale(LC_ALL_MASK, name.c_str(), nullptr);
+            if(tmp) {
+                locale_t* tmp_p;
+                try {
+                    tmp_p = new locale_t(tmp);
+                } catch(...) {
+                    freelocale(tmp);
+                    throw;
+                }
+                lc.reset(tmp_p, free_locale_by_ptr);
+            }
+            boost::unique_lock<boost::mutex> guard(lock);
+            if(locales.size() < max_cached_locales) {
+                // Another thread might have created it meanwhile, use that one
+                return locales.emplace(name, std::move(lc)).first->second;
+            }
+            return lc;
+        }
+
         void prepare_data()
         {
             if(!invalid_)
@@ -68,20 +110,24 @@ namespace boost { namespace locale { namespace impl_posix {
             if(real_id_.empty())
                 real_id_ = util::get_system_locale();
 
-            locale_t tmp = newlocale(LC_ALL_MASK, real_id_.c_str(), nullptr);
-            if(!tmp)
-                tmp = newlocale(LC_ALL_MASK, "C", nullptr);
-            if(!tmp)
-                throw std::runtime_error("newlocale failed");
+            util::locale_data inf;
+            inf.parse(real_id_);
+            util::check_narrow_encoding(inf.encoding());
+            c_locale_ = inf.language() == "C";
 
-            locale_t* tmp_p;
-            try {
-                tmp_p = new locale_t(tmp);
-            } catch(...) {
-                freelocale(tmp);
-                throw;
+            std::string lc_name = real_id_;
+            // Only US-ASCII is left which is handled as its superset UTF-8
+            BOOST_LOCALE_START_CONST_CONDITION
+            if(util::utf8_only && !inf.is_utf8())
+                lc_name = inf.encoding("UTF-8").to_string();
+            BOOST_LOCALE_END_CONST_CONDITION
+            lc_ = get_locale(lc_name);
+            if(!lc_) {
+                lc_ = get_locale("C");
+                c_locale_ = true;
             }
-            lc_ = std::shared_ptr<locale_t>(tmp_p, free_locale_by_ptr);
+            if(!lc_)
+                throw std::runtime_error("newlocale failed");
         }
 
         std::locale install(const std::locale& base, category_t category, char_facet_t type) override
@@ -89,8 +135,12 @@ namespace boost { namespace locale { namespace impl_posix {
             prepare_data();
 
             switch(category) {
-                case category_t::convert: return create_convert(base, lc_, type);
-                case category_t::collation: return create_collate(base, lc_, type);
+                case category_t::convert: {
+                    const std::locale res = create_convert(base, lc_, type);
+                    return c_locale_ ? util::create_c_converter(res, type) : res;
+                }
+                case category_t::collation:
+                    return c_locale_ ? util::create_c_collate(base, type) : create_collate(base, lc_, type);
                 case category_t::formatting: return create_formatting(base, lc_, type);
                 case category_t::parsing: return create_parsing(base, lc_, type);
                 case category_t::codepage: return create_codecvt(base, nl_langinfo_l(CODESET, *lc_), type);
@@ -134,6 +184,22 @@ namespace boost { namespace locale { namespace impl_posix {
             return base;
         }
 
+        std::locale install_all(const std::locale& base, category_t categories, char_facet_t types) override
+        {
+            const category_t numeric = category_t::formatting | category_t::parsing;
+            if(!(categories & category_t::formatting) || !(categories & category_t::parsing))
+                return localization_backend::install_all(base, categories, types);
+            prepare_data();
+            // Formatting and parsing share most of their facets, so install them together.
+            // None of those facets is installed by another category so the order doesn't matter.
+            std::locale result = base;
+            for(char_facet_t ch = character_facet_first; ch <= character_facet_last; ++ch) {
+                if(ch & types)
+                    result = create_formatting_and_parsing(result, lc_, ch);
+            }
+            return localization_backend::install_all(result, categories ^ numeric, types);
+        }
+
     private:
         std::vector<std::string> paths_;
         std::vector<std::string> domains_;
@@ -141,6 +207,7 @@ namespace boost { namespace locale { namespace impl_posix {
         std::string real_id_;
 
         bool invalid_;
+        bool c_locale_;
         std::shared_ptr<locale_t> lc_;
     };
 
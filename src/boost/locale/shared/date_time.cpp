@@ -5,6 +5,7 @@
 // https://www.boost.org/LICENSE_1_0.txt
 
 #include <boost/locale/date_time.hpp>
+#include <boost/locale/default_locale.hpp>
 #include <boost/locale/formatting.hpp>
 #include <boost/core/exchange.hpp>
 #include <boost/thread/locks.hpp>
@@ -26,7 +27,7 @@ namespace boost { namespace locale {
     }
 
     calendar::calendar(const std::string& zone) :
-        tz_(zone), impl_(std::use_facet<calendar_facet>(std::locale()).create_calendar())
+        tz_(zone), impl_(std::use_facet<calendar_facet>(default_locale()).create_calendar())
     {
         impl_->set_timezone(tz_);
     }
@@ -45,7 +46,7 @@ namespace boost { namespace locale {
     }
 
     calendar::calendar() :
-        tz_(time_zone::global()), impl_(std::use_facet<calendar_facet>(std::locale()).create_calendar())
+        tz_(time_zone::global()), impl_(std::use_facet<calendar_facet>(default_locale()).create_calendar())
     {
         impl_->set_timezone(tz_);
     }
@@ -116,7 +117,7 @@ namespace boost { namespace locale {
     // date_time
     /////////////////
 
-    date_time::date_time() : impl_(std::use_facet<calendar_facet>(std::locale()).create_calendar())
+    date_time::date_time() : impl_(std::use_facet<calendar_facet>(default_locale()).create_calendar())
     {
         impl_->set_timezone(time_zone::global());
     }
@@ -137,7 +138,7 @@ namespace boost { namespace locale {
         return *this;
     }
 
-    date_time::date_time(double t) : impl_(std::use_facet<calendar_facet>(std::locale()).create_calendar())
+    date_time::date_time(double t) : impl_(std::use_facet<calendar_facet>(default_locale()).create_calendar())
     {
         impl_->set_timezone(time_zone::global());
         time(t);
@@ -151,7 +152,7 @@ namespace boost { namespace locale {
     date_time::date_time(const calendar& cal) : impl_(cal.impl_->clone()) {}
 
     date_time::date_time(const date_time_period_set& s) :
-        impl_(std::use_facet<calendar_facet>(std::locale()).create_calendar())
+        impl_(std::use_facet<calendar_facet>(default_locale()).create_calendar())
     {
         impl_->set_timezone(time_zone::global());
         for(unsigned i = 0; i < s.size(); i++)
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/locale/default_locale.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace boost { namespace locale {
+
+    namespace {
+        struct global_locale {
+            boost::mutex lock;
+            std::locale loc;
+            /// Set while the global locale is tracked, i.e. after default_locale(const std::locale&)
+            std::atomic<bool> tracked{false};
+            /// Incremented on each change of the tracked global locale
+            std::atomic<uint64_t> version{0};
+        };
+        global_locale& get_global_locale()
+        {
+            static global_locale instance;
+            return instance;
+        }
+
+        struct locale_snapshot {
+            uint64_t version = 0;
+            std::locale loc;
+        };
+        locale_snapshot& get_snapshot()
+        {
+            static thread_local locale_snapshot snapshot;
+            return snapshot;
+        }
+    } // namespace
+
+    const std::locale& default_locale()
+    {
+        global_locale& global = get_global_locale();
+        locale_snapshot& snapshot = get_snapshot();
+        // The global locale may have been changed via std::locale::global at any time
+        if(!global.tracked.load(std::memory_order_acquire)) {
+            const std::locale current;
+            // Keep the previous locale if unchanged so references returned before stay valid
+            if(current != snapshot.loc)
+                snapshot.loc = current;
+        } else if(snapshot.version != global.version.load(std::memory_order_acquire)) {
+            boost::unique_lock<boost::mutex> guard(global.lock);
+            snapshot.loc = global.loc;
+            snapshot.version = global.version.load(std::memory_order_relaxed);
+        }
+        return snapshot.loc;
+    }
+
+    std::locale default_locale(const std::locale& loc)
+    {
+        global_locale& global = get_global_locale();
+        boost::unique_lock<boost::mutex> guard(global.lock);
+        std::locale prev = std::locale::global(loc);
+        global.loc = loc;
+        global.version.fetch_add(1, std::memory_order_release);
+        global.tracked.store(true, std::memory_order_release);
+        return prev;
+    }
+
+    void untrack_default_locale()
+    {
+        global_locale& global = get_global_locale();
+        boost::unique_lock<boost::mutex> guard(global.lock);
+        global.tracked.store(false, std::memory_order_release);
+        // Release the locale and outdate the copies of the threads
+        global.loc = std::locale::classic();
+        global.version.fetch_add(1, std::memory_order_release);
+    }
+
+}} // namespace boost::locale
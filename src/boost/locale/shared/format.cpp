@@ -8,9 +8,13 @@
 #include <boost/locale/generator.hpp>
 #include <boost/locale/info.hpp>
 #include "boost/locale/util/numeric.hpp"
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 namespace boost { namespace locale { namespace detail {
 
@@ -161,5 +165,59 @@ namespace boost { namespace locale { namespace detail {
             imbue(new_loc);
         }
     }
+
+    struct locale_cache::data {
+        struct entry {
+            std::locale loc;
+            int domain_id;
+            std::shared_ptr<const void> value;
+            uint64_t last_use;
+        };
+        // Unnamed (e.g. generated) locales only compare equal to copies of themselves,
+        // so the comparison is cheap and only a few entries are kept.
+        mutable std::vector<entry> entries;
+        mutable uint64_t use_count = 0;
+        mutable boost::mutex lock;
+
+        entry* find(const std::locale& loc, int domain_id) const
+        {
+            for(entry& e : entries) {
+                if(e.domain_id == domain_id && e.loc == loc) {
+                    e.last_use = ++use_count;
+                    return &e;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    locale_cache::locale_cache() : d(new data) {}
+    locale_cache::~locale_cache() = default;
+
+    std::shared_ptr<const void> locale_cache::find(const std::locale& loc, int domain_id) const
+    {
+        boost::unique_lock<boost::mutex> guard(d->lock);
+        const data::entry* e = d->find(loc, domain_id);
+        return e ? e->value : nullptr;
+    }
+
+    std::shared_ptr<const void>
+    locale_cache::insert(const std::locale& loc, int domain_id, std::shared_ptr<const void> value) const
+    {
+        boost::unique_lock<boost::mutex> guard(d->lock);
+        if(const data::entry* existing = d->find(loc, domain_id))
+            return existing->value;
+        if(d->entries.size() < max_size)
+            d->entries.push_back(data::entry{loc, domain_id, value, ++d->use_count});
+        else {
+            // Replace the least recently used entry releasing its locale
+            const auto lru = std::min_element(
+              d->entries.begin(), d->entries.end(), [](const data::entry& l, const data::entry& r) {
+                  return l.last_use < r.last_use;
+              });
+            *lru = data::entry{loc, domain_id, value, ++d->use_count};
+        }
+        return value;
+    }
 }}} // namespace boost::locale::detail
 // boostinspect:nominmax
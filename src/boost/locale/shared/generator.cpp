@@ -7,27 +7,177 @@
 #include <boost/locale/encoding.hpp>
 #include <boost/locale/generator.hpp>
 #include <boost/locale/localization_backend.hpp>
+#include "boost/locale/util/atomic_shared_ptr.hpp"
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <thread>
 #include <vector>
 
 namespace boost { namespace locale {
+
     struct generator::data {
         data(const localization_backend_manager& mgr) :
-            cats(all_categories), chars(all_characters), caching_enabled(false), use_ansi_encoding(false),
-            backend_manager(mgr)
+            cached(std::make_shared<cache_table>(min_cache_buckets)), cache_size(0), cache_limit(0), cache_clock(0),
+            cache_misses(0), cache_evictions(0), cats(all_categories), chars(all_characters), caching_enabled(false),
+            use_ansi_encoding(false), lazy_facets(false), backend_manager(mgr)
         {}
 
-        mutable std::map<std::string, std::locale> cached;
+        /// Immutable entry of a bucket of the cache, except for its usage time
+        struct cache_node {
+            cache_node(const std::string& i, const std::locale& l, uint64_t use, std::shared_ptr<const cache_node> n) :
+                id(i), loc(l), last_use(use), next(std::move(n))
+            {}
+            const std::string id;
+            const std::locale loc;
+            /// Value of cache_clock when last used, approximates the LRU order
+            mutable std::atomic<uint64_t> last_use;
+            const std::shared_ptr<const cache_node> next;
+        };
+        /// Hash table of the cached locales.
+        ///
+        /// Each bucket is an immutable list which is replaced as a whole, so it can be read without locking
+        /// while a writer holding the lock replaces it. Adding or removing a locale only copies (part of)
+        /// one bucket, the table itself is only copied when it grows.
+        struct cache_table {
+            explicit cache_table(size_t num_buckets) : buckets(num_buckets) {}
+            util::atomic_shared_ptr<const cache_node>& bucket(const std::string& id)
+            {
+                return buckets[std::hash<std::string>()(id) % buckets.size()];
+            }
+            std::vector<util::atomic_shared_ptr<const cache_node>> buckets;
+        };
+        static constexpr size_t min_cache_buckets = 16;
+
+        /// Counter padded to avoid false sharing with other counters
+        struct hit_counter {
+            std::atomic<uint64_t> value{0};
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+        /// Hits are counted in multiple counters chosen by the thread to avoid contention on a single one
+        static constexpr size_t num_hit_counters = 16;
+
+        void count_hit() const
+        {
+            const size_t idx = std::hash<std::thread::id>()(std::this_thread::get_id()) % num_hit_counters;
+            cache_hits[idx].value.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint64_t total_cache_hits() const
+        {
+            uint64_t result = 0;
+            for(const hit_counter& counter : cache_hits)
+                result += counter.value.load(std::memory_order_relaxed);
+            return result;
+        }
+
+        /// Find the locale \a id in the cache or return NULL, doesn't lock
+        std::shared_ptr<const cache_node> find(const std::string& id) const
+        {
+            std::shared_ptr<const cache_node> node = cached.load()->bucket(id).load();
+            while(node && node->id != id)
+                node = node->next;
+            return node;
+        }
+
+        /// Add locale \a loc for \a id if not yet cached, requires the lock to be held
+        void insert(const std::string& id, const std::locale& loc) const
+        {
+            std::shared_ptr<cache_table> table = cached.load();
+            util::atomic_shared_ptr<const cache_node>& bucket = table->bucket(id);
+            for(auto node = bucket.load(); node; node = node->next) {
+                if(node->id == id)
+                    return;
+            }
+            // Advance by 2 so locales used after this one count as more recently used
+            const uint64_t now = (cache_clock += 2) - 1;
+            bucket.store(std::make_shared<const cache_node>(id, loc, now, bucket.load()));
+            ++cache_size;
+            if(cache_limit != 0)
+                evict(cache_limit);
+            if(cache_size > 2 * table->buckets.size())
+                rehash(2 * table->buckets.size());
+        }
+
+        /// Remove the node \a to_remove, requires the lock to be held
+        void remove(const cache_node& to_remove) const
+        {
+            util::atomic_shared_ptr<const cache_node>& bucket = cached.load()->bucket(to_remove.id);
+            // Copy the nodes before the removed one, the ones after can be shared
+            std::vector<const cache_node*> before;
+            const cache_node* node = bucket.load().get();
+            for(; node != &to_remove; node = node->next.get())
+                before.push_back(node);
+            std::shared_ptr<const cache_node> head = to_remove.next;
+            for(auto it = before.rbegin(); it != before.rend(); ++it) {
+                const cache_node& n = **it;
+                head = std::make_shared<const cache_node>(n.id, n.loc, n.last_use.load(std::memory_order_relaxed), head);
+            }
+            bucket.store(std::move(head));
+            --cache_size;
+        }
+
+        /// Remove the least recently used locales until at most \a limit remain, requires the lock to be held
+        void evict(size_t limit) const
+        {
+            const std::shared_ptr<cache_table> table = cached.load();
+            while(cache_size > limit) {
+                std::shared_ptr<const cache_node> oldest;
+                for(const auto& bucket : table->buckets) {
+                    for(auto node = bucket.load(); node; node = node->next) {
+                        if(!oldest
+                           || node->last_use.load(std::memory_order_relaxed)
+                                < oldest->last_use.load(std::memory_order_relaxed))
+                            oldest = node;
+                    }
+                }
+                remove(*oldest);
+                ++cache_evictions;
+            }
+        }
+
+        /// Move all locales to a new table with \a num_buckets buckets, requires the lock to be held
+        void rehash(size_t num_buckets) const
+        {
+            const std::shared_ptr<cache_table> table = cached.load();
+            auto new_table = std::make_shared<cache_table>(num_buckets);
+            for(const auto& bucket : table->buckets) {
+                for(auto node = bucket.load(); node; node = node->next) {
+                    util::atomic_shared_ptr<const cache_node>& new_bucket = new_table->bucket(node->id);
+                    new_bucket.store(std::make_shared<const cache_node>(
+                      node->id, node->loc, node->last_use.load(std::memory_order_relaxed), new_bucket.load()));
+                }
+            }
+            cached.store(std::move(new_table));
+        }
+
+        /// Remove all locales, requires the lock to be held
+        void clear()
+        {
+            cached.store(std::make_shared<cache_table>(min_cache_buckets));
+            cache_size = 0;
+        }
+
+        // Buckets are replaced atomically, the table when it is resized or cleared
+        mutable util::atomic_shared_ptr<cache_table> cached;
+        // Serializes modifications of the cache
         mutable boost::mutex cached_lock;
+        mutable size_t cache_size;
+        size_t cache_limit;
+        mutable std::atomic<uint64_t> cache_clock;
+        mutable hit_counter cache_hits[num_hit_counters];
+        mutable std::atomic<uint64_t> cache_misses;
+        mutable std::atomic<uint64_t> cache_evictions;
 
         category_t cats;
         char_facet_t chars;
 
         bool caching_enabled;
         bool use_ansi_encoding;
+        bool lazy_facets;
 
         std::vector<std::string> paths;
         std::vector<std::string> domains;
@@ -37,6 +187,9 @@ namespace boost { namespace locale {
         localization_backend_manager backend_manager;
     };
 
+    constexpr size_t generator::data::min_cache_buckets;
+    constexpr size_t generator::data::num_hit_counters;
+
     generator::generator(const localization_backend_manager& mgr) : d(new generator::data(mgr)) {}
     generator::generator() : d(new generator::data(localization_backend_manager::global())) {}
     generator::~generator() = default;
@@ -88,7 +241,8 @@ namespace boost { namespace locale {
     }
     void generator::clear_cache()
     {
-        d->cached.clear();
+        boost::unique_lock<boost::mutex> guard(d->cached_lock);
+        d->clear();
     }
 
     std::locale generator::generate(const std::string& id) const
@@ -101,35 +255,24 @@ namespace boost { namespace locale {
     std::locale generator::generate(const std::locale& base, const std::string& id) const
     {
         if(d->caching_enabled) {
-            boost::unique_lock<boost::mutex> guard(d->cached_lock);
-            const auto p = d->cached.find(id);
-            if(p != d->cached.end())
-                return p->second;
+            const auto node = d->find(id);
+            if(node) {
+                d->count_hit();
+                const uint64_t now = d->cache_clock.load(std::memory_order_relaxed);
+                // Avoid writing to the shared entry when it was already used since the last insertion
+                if(node->last_use.load(std::memory_order_relaxed) != now)
+                    node->last_use.store(now, std::memory_order_relaxed);
+                return node->loc;
+            }
+            ++d->cache_misses;
         }
         auto backend = d->backend_manager.create();
         set_all_options(*backend, id);
 
-        std::locale result = base;
-        category_t facets = d->cats;
-        char_facet_t chars = d->chars;
-
-        for(category_t facet = per_character_facet_first; facet <= per_character_facet_last; ++facet) {
-            if(!(facets & facet))
-                continue;
-            for(char_facet_t ch = character_facet_first; ch <= character_facet_last; ++ch) {
-                if(ch & chars)
-                    result = backend->install(result, facet, ch);
-            }
-        }
-        for(category_t facet = non_character_facet_first; facet <= non_character_facet_last; ++facet) {
-            if(facets & facet)
-                result = backend->install(result, facet, char_facet_t::nochar);
-        }
+        const std::locale result = backend->install_all(base, d->cats, d->chars);
         if(d->caching_enabled) {
             boost::unique_lock<boost::mutex> guard(d->cached_lock);
-            const auto p = d->cached.find(id);
-            if(p == d->cached.end())
-                d->cached[id] = result;
+            d->insert(id, result);
         }
         return result;
     }
@@ -144,6 +287,16 @@ namespace boost { namespace locale {
         d->use_ansi_encoding = v;
     }
 
+    bool generator::lazy_facets() const
+    {
+        return d->lazy_facets;
+    }
+
+    void generator::lazy_facets(bool v)
+    {
+        d->lazy_facets = v;
+    }
+
     bool generator::locale_cache_enabled() const
     {
         return d->caching_enabled;
@@ -153,10 +306,34 @@ namespace boost { namespace locale {
         d->caching_enabled = enabled;
     }
 
+    size_t generator::locale_cache_limit() const
+    {
+        return d->cache_limit;
+    }
+    void generator::locale_cache_limit(size_t max_locales)
+    {
+        boost::unique_lock<boost::mutex> guard(d->cached_lock);
+        d->cache_limit = max_locales;
+        if(max_locales != 0)
+            d->evict(max_locales);
+    }
+
+    generator::cache_statistics generator::locale_cache_statistics() const
+    {
+        cache_statistics result;
+        result.hits = d->total_cache_hits();
+        result.misses = d->cache_misses.load();
+        result.evictions = d->cache_evictions.load();
+        boost::unique_lock<boost::mutex> guard(d->cached_lock);
+        result.size = d->cache_size;
+        return result;
+    }
+
     void generator::set_all_options(localization_backend& backend, const std::string& id) const
     {
         backend.set_option("locale", id);
         backend.set_option("use_ansi_encoding", d->use_ansi_encoding ? "true" : "false");
+        backend.set_option("lazy_facets", d->lazy_facets ? "true" : "false");
         for(const std::string& domain : d->domains)
             backend.set_option("message_application", domain);
         for(const std::string& path : d->paths)
@@ -5,9 +5,7 @@
 // https://www.boost.org/LICENSE_1_0.txt
 
 #include <boost/locale/localization_backend.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/mutex.hpp>
-#include <functional>
+#include "boost/locale/util/atomic_shared_ptr.hpp"
 #include <memory>
 #include <vector>
 
@@ -35,24 +33,29 @@ namespace boost { namespace locale {
 
     localization_backend::~localization_backend() = default;
 
+    std::locale localization_backend::install_all(const std::locale& base, category_t categories, char_facet_t types)
+    {
+        std::locale result = base;
+        for(category_t category = per_character_facet_first; category <= per_character_facet_last; ++category) {
+            if(!(categories & category))
+                continue;
+            for(char_facet_t type = character_facet_first; type <= character_facet_last; ++type) {
+                if(type & types)
+                    result = install(result, category, type);
+            }
+        }
+        for(category_t category = non_character_facet_first; category <= non_character_facet_last; ++category) {
+            if(categories & category)
+                result = install(result, category, char_facet_t::nochar);
+        }
+        return result;
+    }
+
     class localization_backend_manager::impl {
     public:
-        impl(const impl& other) : default_backends_(other.default_backends_)
-        {
-            for(const auto& i : other.all_backends_)
-                all_backends_.push_back({i.first, clone(*i.second)});
-        }
         impl() : default_backends_(32, -1) {}
 
-        impl& operator=(const impl&) = delete;
-
-        localization_backend* create() const
-        {
-            std::vector<std::reference_wrapper<const localization_backend>> backends;
-            for(const auto& i : all_backends_)
-                backends.push_back(std::cref(*i.second));
-            return new actual_backend(backends, default_backends_);
-        }
+        localization_backend* create() const { return new actual_backend(all_backends_, default_backends_); }
 
         int find_backend(const std::string& name) const
         {
@@ -70,7 +73,7 @@ namespace boost { namespace locale {
             if(all_backends_.empty())
                 std::fill(default_backends_.begin(), default_backends_.end(), 0);
             if(BOOST_LIKELY(find_backend(name) < 0))
-                all_backends_.push_back(std::make_pair(name, std::move(ptr)));
+                all_backends_.emplace_back(name, std::move(ptr));
         }
 
         void select(const std::string& backend_name, category_t category = all_categories)
@@ -100,71 +103,119 @@ namespace boost { namespace locale {
         }
 
     private:
+        // The registered backends are prototypes which are never modified,
+        // so they can be shared by all copies of the manager
+        typedef std::vector<std::pair<std::string, std::shared_ptr<const localization_backend>>> backends_type;
+
         class actual_backend : public localization_backend {
         public:
-            actual_backend(const std::vector<std::reference_wrapper<const localization_backend>>& backends,
-                           const std::vector<int>& index) :
-                index_(index)
+            actual_backend(const backends_type& backends, const std::vector<int>& index) :
+                backends_(backends.size()), index_(index)
             {
-                for(const localization_backend& b : backends)
-                    backends_.push_back(boost::locale::clone(b));
+                // Only the backends selected for any category are used
+                for(const int id : index_) {
+                    if(id >= 0 && !backends_[id])
+                        backends_[id] = boost::locale::clone(*backends[id].second);
+                }
             }
-            actual_backend* clone() const override
+            actual_backend(const actual_backend& other) :
+                localization_backend(), backends_(other.backends_.size()), index_(other.index_)
             {
-                std::vector<std::reference_wrapper<const localization_backend>> backends;
-                for(const auto& b : backends_)
-                    backends.push_back(std::cref(*b));
-                return new actual_backend(backends, index_);
+                for(size_t i = 0; i < backends_.size(); ++i) {
+                    if(other.backends_[i])
+                        backends_[i] = boost::locale::clone(*other.backends_[i]);
+                }
             }
+            actual_backend* clone() const override { return new actual_backend(*this); }
             void set_option(const std::string& name, const std::string& value) override
             {
-                for(const auto& b : backends_)
-                    b->set_option(name, value);
+                for(const auto& b : backends_) {
+                    if(b)
+                        b->set_option(name, value);
+                }
             }
             void clear_options() override
             {
-                for(const auto& b : backends_)
-                    b->clear_options();
+                for(const auto& b : backends_) {
+                    if(b)
+                        b->clear_options();
+                }
             }
             std::locale install(const std::locale& l, category_t category, char_facet_t type) override
+            {
+                const int backend = backend_id(category);
+                if(backend == -1)
+                    return l;
+                return backends_[backend]->install(l, category, type);
+            }
+            std::locale install_all(const std::locale& l, category_t categories, char_facet_t types) override
+            {
+                // Pass each run of categories handled by the same backend at once.
+                // This keeps the order of installation the same as for individual categories
+                std::locale result = l;
+                int cur_backend = -1;
+                category_t cur_categories{};
+                for(category_t category = per_character_facet_first; category <= non_character_facet_last; ++category) {
+                    if(!(categories & category))
+                        continue;
+                    const int backend = backend_id(category);
+                    if(backend != cur_backend) {
+                        if(cur_backend != -1)
+                            result = backends_[cur_backend]->install_all(result, cur_categories, types);
+                        cur_backend = backend;
+                        cur_categories = category_t{};
+                    }
+                    cur_categories = cur_categories | category;
+                }
+                if(cur_backend != -1)
+                    result = backends_[cur_backend]->install_all(result, cur_categories, types);
+                return result;
+            }
+
+        private:
+            /// Index of the backend selected for the category or -1 if none
+            int backend_id(category_t category) const
             {
                 unsigned id = 0;
                 for(category_t v = category_first; v != category; ++v, ++id) {
                     if(v == category_last)
-                        return l;
+                        return -1;
                 }
-                if(id >= index_.size() || index_[id] == -1)
-                    return l;
-                return backends_[index_[id]]->install(l, category, type);
+                return id < index_.size() ? index_[id] : -1;
             }
 
-        private:
             std::vector<std::unique_ptr<localization_backend>> backends_;
             std::vector<int> index_;
         };
 
-        std::vector<std::pair<std::string, std::unique_ptr<localization_backend>>> all_backends_;
+        backends_type all_backends_;
         std::vector<int> default_backends_;
     };
 
-    localization_backend_manager::localization_backend_manager() : pimpl_(new impl()) {}
+    localization_backend_manager::localization_backend_manager() : pimpl_(std::make_shared<impl>()) {}
+    localization_backend_manager::localization_backend_manager(std::shared_ptr<const impl> pimpl) :
+        pimpl_(std::move(pimpl))
+    {}
 
     localization_backend_manager::~localization_backend_manager() = default;
 
-    localization_backend_manager::localization_backend_manager(const localization_backend_manager& other) :
-        pimpl_(new impl(*other.pimpl_))
-    {}
-
-    localization_backend_manager& localization_backend_manager::operator=(const localization_backend_manager& other)
-    {
-        pimpl_.reset(new impl(*other.pimpl_));
-        return *this;
-    }
+    localization_backend_manager::localization_backend_manager(const localization_backend_manager&) = default;
+    localization_backend_manager&
+    localization_backend_manager::operator=(const localization_backend_manager&) = default;
 
     localization_backend_manager::localization_backend_manager(localization_backend_manager&&) noexcept = default;
     localization_backend_manager&
     localization_backend_manager::operator=(localization_backend_manager&&) noexcept = default;
 
+    localization_backend_manager::impl& localization_backend_manager::modify()
+    {
+        // Copy on write as the state may be shared with other managers
+        auto new_impl = std::make_shared<impl>(*pimpl_);
+        impl& result = *new_impl;
+        pimpl_ = std::move(new_impl);
+        return result;
+    }
+
     std::unique_ptr<localization_backend> localization_backend_manager::create() const
     {
         return std::unique_ptr<localization_backend>(pimpl_->create());
@@ -172,12 +223,12 @@ namespace boost { namespace locale {
     void localization_backend_manager::add_backend(const std::string& name,
                                                    std::unique_ptr<localization_backend> backend)
     {
-        pimpl_->add_backend(name, std::move(backend));
+        modify().add_backend(name, std::move(backend));
     }
 
     void localization_backend_manager::remove_all_backends()
     {
-        pimpl_->remove_all_backends();
+        modify().remove_all_backends();
     }
     std::vector<std::string> localization_backend_manager::get_all_backends() const
     {
@@ -185,7 +236,7 @@ namespace boost { namespace locale {
     }
     void localization_backend_manager::select(const std::string& backend_name, category_t category)
     {
-        pimpl_->select(backend_name, category);
+        modify().select(backend_name, category);
     }
 
     namespace {
@@ -211,27 +262,23 @@ namespace boost { namespace locale {
             return mgr;
         }
 
-        boost::mutex& localization_backend_manager_mutex()
-        {
-            static boost::mutex the_mutex;
-            return the_mutex;
-        }
-        localization_backend_manager& localization_backend_manager_global()
+        /// The global manager is immutable and replaced as a whole, so copying it only needs an atomic load
+        util::atomic_shared_ptr<const localization_backend_manager>& localization_backend_manager_global()
         {
-            static localization_backend_manager the_manager = make_default_backend_mgr();
+            static util::atomic_shared_ptr<const localization_backend_manager> the_manager(
+              std::make_shared<const localization_backend_manager>(make_default_backend_mgr()));
             return the_manager;
         }
     } // namespace
 
     localization_backend_manager localization_backend_manager::global()
     {
-        boost::unique_lock<boost::mutex> lock(localization_backend_manager_mutex());
-        return localization_backend_manager_global();
+        return *localization_backend_manager_global().load();
     }
     localization_backend_manager localization_backend_manager::global(const localization_backend_manager& in)
     {
-        boost::unique_lock<boost::mutex> lock(localization_backend_manager_mutex());
-        return exchange(localization_backend_manager_global(), in);
+        auto& global_mgr = localization_backend_manager_global();
+        return *global_mgr.exchange(std::make_shared<const localization_backend_manager>(in));
     }
 
 }} // namespace boost::locale
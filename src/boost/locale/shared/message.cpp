@@ -19,17 +19,22 @@
 #include <boost/locale/gnu_gettext.hpp>
 
 #include <boost/locale/encoding.hpp>
+#include <boost/locale/format.hpp>
 #include <boost/locale/message.hpp>
 #include "boost/locale/shared/mo_hash.hpp"
 #include "boost/locale/shared/mo_lambda.hpp"
 #include "boost/locale/util/encoding.hpp"
 #include "boost/locale/util/foreach_char.hpp"
+#include "boost/locale/util/make_std_unique.hpp"
 #include <boost/assert.hpp>
 #include <boost/utility/string_view.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -453,6 +458,12 @@ namespace boost { namespace locale { namespace gnu_gettext {
                         break;
                 }
             }
+            std::vector<const CharType*> formats;
+            for(const domain_data_type& data : domain_data_)
+                find_formats(data, formats);
+            formats_.reserve(formats.size());
+            for(const CharType* format : formats)
+                formats_.emplace(std::piecewise_construct, std::forward_as_tuple(format), std::tuple<>());
         }
 
         const CharType* convert(const CharType* msg, string_type& buffer) const override
@@ -460,6 +471,12 @@ namespace boost { namespace locale { namespace gnu_gettext {
             return runtime_conversion<CharType>(msg, buffer, key_conversion_required_, locale_encoding_, key_encoding_);
         }
 
+        const detail::compiled_format<CharType>* get_format(const CharType* translation) const override
+        {
+            const auto p = formats_.find(translation);
+            return p == formats_.end() ? nullptr : p->second.get(translation);
+        }
+
     private:
         bool load_file(const std::string& file_name,
                        const std::string& locale_encoding,
@@ -514,6 +531,59 @@ namespace boost { namespace locale { namespace gnu_gettext {
             return true;
         }
 
+        /// Add the translations of the catalog which contain placeholders to \a formats
+        static void find_formats(const domain_data_type& data, std::vector<const CharType*>& formats)
+        {
+            BOOST_LOCALE_START_CONST_CONDITION
+            if(mo_file_use_traits<CharType>::in_use && data.mo_catalog) {
+                BOOST_LOCALE_END_CONST_CONDITION
+                for(unsigned i = 0; i < data.mo_catalog->size(); i++) {
+                    const auto value = data.mo_catalog->value(i);
+                    find_formats(reinterpret_cast<const CharType*>(value.data()),
+                                 reinterpret_cast<const CharType*>(value.data() + value.size()),
+                                 formats);
+                }
+            } else {
+                for(const auto& entry : data.catalog)
+                    find_formats(entry.second.data(), entry.second.data() + entry.second.size(), formats);
+            }
+        }
+
+        /// Add the plural forms in [\a begin, \a end) separated by NUL characters which contain placeholders
+        static void find_formats(const CharType* begin, const CharType* end, std::vector<const CharType*>& formats)
+        {
+            for(const CharType* form = begin; form < end;) {
+                const CharType* form_end = std::find(form, end, CharType(0));
+                if(std::find(form, form_end, CharType('{')) != form_end)
+                    formats.push_back(form);
+                form = form_end + 1;
+            }
+        }
+
+        /// The parsed format of a translation, created on first use
+        class format_slot {
+        public:
+            format_slot() : format_(nullptr) {}
+            format_slot(const format_slot&) = delete;
+            format_slot& operator=(const format_slot&) = delete;
+            ~format_slot() { delete format_.load(std::memory_order_relaxed); }
+
+            const detail::compiled_format<CharType>* get(const CharType* translation) const
+            {
+                const detail::compiled_format<CharType>* format = format_.load(std::memory_order_acquire);
+                if(format)
+                    return format;
+                auto created = make_std_unique<const detail::compiled_format<CharType>>(translation);
+                // If another thread was faster use its result
+                if(format_.compare_exchange_strong(format, created.get(), std::memory_order_acq_rel))
+                    format = created.release();
+                return format;
+            }
+
+        private:
+            mutable std::atomic<const detail::compiled_format<CharType>*> format_;
+        };
+
         // Check if the mo file as-is is useful
         // 1. It is char and not wide character
         // 2. The locale encoding and mo encoding is same
@@ -574,6 +644,10 @@ namespace boost { namespace locale { namespace gnu_gettext {
         std::string locale_encoding_;
         std::string key_encoding_;
         bool key_conversion_required_;
+
+        /// Parsed formats of the translations with placeholders. The entries are added when loading the catalogs
+        /// and parsed on first use. The catalogs are immutable, so a translation is identified by its address.
+        std::unordered_map<const CharType*, format_slot> formats_;
     };
 
     template<typename CharType, class /* enable_if */>
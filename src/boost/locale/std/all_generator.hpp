@@ -34,6 +34,12 @@ namespace boost { namespace locale { namespace impl_std {
     std::locale
     create_parsing(const std::locale& in, const std::string& locale_name, char_facet_t type, utf8_support utf);
 
+    /// Same as create_formatting followed by create_parsing but without installing shared facets twice
+    std::locale create_formatting_and_parsing(const std::locale& in,
+                                              const std::string& locale_name,
+                                              char_facet_t type,
+                                              utf8_support utf);
+
     std::locale
     create_codecvt(const std::locale& in, const std::string& locale_name, char_facet_t type, utf8_support utf);
 
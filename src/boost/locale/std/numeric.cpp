@@ -310,4 +310,16 @@ namespace boost { namespace locale { namespace impl_std {
         return in;
     }
 
+    std::locale create_formatting_and_parsing(const std::locale& in,
+                                              const std::string& locale_name,
+                                              char_facet_t type,
+                                              utf8_support utf)
+    {
+        // The formatting facets include all parsing facets except the num_get for UTF-8
+        std::locale res = create_formatting(in, locale_name, type, utf);
+        if(type == char_facet_t::char_f && utf != utf8_support::none)
+            res = std::locale(res, new util::base_num_parse<char>());
+        return res;
+    }
+
 }}} // namespace boost::locale::impl_std
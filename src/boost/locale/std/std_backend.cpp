@@ -12,9 +12,22 @@
 #include <boost/locale/util/locale_data.hpp>
 #include <boost/assert.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <algorithm>
 #include <iterator>
+#include <unordered_map>
 #include <vector>
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+#    define BOOST_LOCALE_STD_HAS_NEWLOCALE
+#    include <clocale>
+#    if defined(__APPLE__) || defined(__FreeBSD__)
+#        include <xlocale.h>
+#    endif
+#elif BOOST_LOCALE_USE_WIN32_API && defined(_MSC_VER)
+#    define BOOST_LOCALE_STD_HAS_CREATE_LOCALE
+#    include <locale.h>
+#endif
 
 #if BOOST_LOCALE_USE_WIN32_API
 #    ifndef NOMINMAX
@@ -24,6 +37,7 @@
 #    include <windows.h>
 #endif
 #include "boost/locale/std/all_generator.hpp"
+#include "boost/locale/util/c_locale_facets.hpp"
 #include "boost/locale/util/encoding.hpp"
 #include "boost/locale/util/gregorian.hpp"
 #include "boost/locale/util/make_std_unique.hpp"
@@ -62,6 +76,19 @@ windows_name to_windows_name(const std::string& l)
 
 bool loadable(const std::string& name)
 {
+    // The standard library creates named locales via the C library, so check for them without throwing an exception
+    // if they don't exist. If they do, still check that the standard library accepts the name.
+#if defined(BOOST_LOCALE_STD_HAS_NEWLOCALE)
+    const locale_t tmp = newlocale(LC_ALL_MASK, name.c_str(), nullptr);
+    if(!tmp)
+        return false;
+    freelocale(tmp);
+#elif defined(BOOST_LOCALE_STD_HAS_CREATE_LOCALE)
+    const _locale_t tmp = _create_locale(LC_ALL, name.c_str());
+    if(!tmp)
+        return false;
+    _free_locale(tmp);
+#endif
     try {
         std::locale l(name);
         return true;
@@ -73,6 +100,90 @@ bool loadable(const std::string& name)
 
 namespace boost { namespace locale { namespace impl_std {
 
+    namespace {
+        struct resolved_name {
+            std::string name;
+            utf8_support utf_mode;
+        };
+
+        resolved_name find_std_name(const std::string& lid, const util::locale_data& data)
+        {
+            resolved_name res;
+            const auto l_win = to_windows_name(lid);
+
+            if(!data.is_utf8()) {
+                res.utf_mode = utf8_support::none;
+                if(loadable(lid))
+                    res.name = lid;
+                else if(l_win && loadable(l_win.name)) {
+                    if(util::are_encodings_equal(l_win.codepage, data.encoding()))
+                        res.name = l_win.name;
+                    else {
+                        int codepage_int;
+                        if(util::try_to_int(l_win.codepage, codepage_int)
+                           && codepage_int == util::encoding_to_windows_codepage(data.encoding()))
+                        {
+                            res.name = l_win.name;
+                        } else
+                            res.name = "C";
+                    }
+                } else
+                    res.name = "C";
+            } else {
+                if(loadable(lid)) {
+                    res.name = lid;
+                    res.utf_mode = utf8_support::native;
+                } else {
+                    std::vector<std::string> alt_names;
+                    if(l_win)
+                        alt_names.push_back(l_win.name);
+                    // Try different spellings
+                    alt_names.push_back(util::locale_data(data).encoding("UTF-8").to_string());
+                    alt_names.push_back(util::locale_data(data).encoding("utf8", false).to_string());
+                    // Without encoding, let from_wide classes handle it
+                    alt_names.push_back(util::locale_data(data).encoding("").to_string());
+                    // Final try: Classic locale, but enable Unicode (if supported)
+                    alt_names.push_back("C.UTF-8");
+                    alt_names.push_back("C.utf8");
+                    // If everything fails rely on the classic locale
+                    alt_names.push_back("C");
+                    for(const std::string& name : alt_names) {
+                        if(loadable(name)) {
+                            res.name = name;
+                            break;
+                        }
+                    }
+                    BOOST_ASSERT(!res.name.empty());
+                    res.utf_mode = utf8_support::from_wide;
+                }
+            }
+            return res;
+        }
+
+        /// Get the name of the std-locale to use for the locale \a lid.
+        ///
+        /// Finding it requires trying to create multiple locales, so the result is cached for the process
+        resolved_name resolve_name(const std::string& lid, const util::locale_data& data)
+        {
+            // Bounds the memory used when many different ids are requested, further ones are resolved each time
+            constexpr size_t max_cached_names = 64;
+            static boost::mutex lock;
+            static std::unordered_map<std::string, resolved_name> names;
+
+            {
+                boost::unique_lock<boost::mutex> guard(lock);
+                const auto it = names.find(lid);
+                if(it != names.end())
+                    return it->second;
+            }
+            resolved_name res = find_std_name(lid, data);
+            boost::unique_lock<boost::mutex> guard(lock);
+            if(names.size() < max_cached_names)
+                names.emplace(lid, res);
+            return res;
+        }
+    } // namespace
+
     class std_localization_backend : public localization_backend {
     public:
         std_localization_backend() : invalid_(true), use_ansi_encoding_(false) {}
@@ -115,55 +226,18 @@ namespace boost { namespace locale { namespace impl_std {
             }
             in_use_id_ = lid;
             data_.parse(lid);
-
-            const auto l_win = to_windows_name(lid);
-
-            if(!data_.is_utf8()) {
-                utf_mode_ = utf8_support::none;
-                if(loadable(lid))
-                    name_ = lid;
-                else if(l_win && loadable(l_win.name)) {
-                    if(util::are_encodings_equal(l_win.codepage, data_.encoding()))
-                        name_ = l_win.name;
-                    else {
-                        int codepage_int;
-                        if(util::try_to_int(l_win.codepage, codepage_int)
-                           && codepage_int == util::encoding_to_windows_codepage(data_.encoding()))
-                        {
-                            name_ = l_win.name;
-                        } else
-                            name_ = "C";
-                    }
-                } else
-                    name_ = "C";
-            } else {
-                if(loadable(lid)) {
-                    name_ = lid;
-                    utf_mode_ = utf8_support::native;
-                } else {
-                    std::vector<std::string> alt_names;
-                    if(l_win)
-                        alt_names.push_back(l_win.name);
-                    // Try different spellings
-                    alt_names.push_back(util::locale_data(data_).encoding("UTF-8").to_string());
-                    alt_names.push_back(util::locale_data(data_).encoding("utf8", false).to_string());
-                    // Without encoding, let from_wide classes handle it
-                    alt_names.push_back(util::locale_data(data_).encoding("").to_string());
-                    // Final try: Classic locale, but enable Unicode (if supported)
-                    alt_names.push_back("C.UTF-8");
-                    alt_names.push_back("C.utf8");
-                    // If everything fails rely on the classic locale
-                    alt_names.push_back("C");
-                    for(const std::string& name : alt_names) {
-                        if(loadable(name)) {
-                            name_ = name;
-                            break;
-                        }
-                    }
-                    BOOST_ASSERT(!name_.empty());
-                    utf_mode_ = utf8_support::from_wide;
-                }
+            util::check_narrow_encoding(data_.encoding());
+            // Only US-ASCII is left which is handled as its superset UTF-8
+            BOOST_LOCALE_START_CONST_CONDITION
+            if(util::utf8_only && !data_.is_utf8()) {
+                data_.encoding("UTF-8");
+                lid = data_.to_string();
             }
+            BOOST_LOCALE_END_CONST_CONDITION
+
+            const resolved_name resolved = resolve_name(lid, data_);
+            name_ = resolved.name;
+            utf_mode_ = resolved.utf_mode;
         }
 
         std::locale install(const std::locale& base, category_t category, char_facet_t type) override
@@ -171,8 +245,14 @@ namespace boost { namespace locale { namespace impl_std {
             prepare_data();
 
             switch(category) {
-                case category_t::convert: return create_convert(base, name_, type, utf_mode_);
-                case category_t::collation: return create_collate(base, name_, type, utf_mode_);
+                case category_t::convert: {
+                    const std::locale res = create_convert(base, name_, type, utf_mode_);
+                    return is_c_locale() ? util::create_c_converter(res, type) : res;
+                }
+                case category_t::collation:
+                    if(is_c_locale())
+                        return util::create_c_collate(base, type);
+                    return create_collate(base, name_, type, utf_mode_);
                 case category_t::formatting: return create_formatting(base, name_, type, utf_mode_);
                 case category_t::parsing: return create_parsing(base, name_, type, utf_mode_);
                 case category_t::codepage: return create_codecvt(base, name_, type, utf_mode_);
@@ -210,7 +290,25 @@ namespace boost { namespace locale { namespace impl_std {
             return base;
         }
 
+        std::locale install_all(const std::locale& base, category_t categories, char_facet_t types) override
+        {
+            const category_t numeric = category_t::formatting | category_t::parsing;
+            if(!(categories & category_t::formatting) || !(categories & category_t::parsing))
+                return localization_backend::install_all(base, categories, types);
+            prepare_data();
+            // Formatting and parsing share most of their facets, so install them together.
+            // None of those facets is installed by another category so the order doesn't matter.
+            std::locale result = base;
+            for(char_facet_t ch = character_facet_first; ch <= character_facet_last; ++ch) {
+                if(ch & types)
+                    result = create_formatting_and_parsing(result, name_, ch, utf_mode_);
+            }
+            return localization_backend::install_all(result, categories ^ numeric, types);
+        }
+
     private:
+        bool is_c_locale() const { return data_.language() == "C"; }
+
         std::vector<std::string> paths_;
         std::vector<std::string> domains_;
         std::string locale_id_;
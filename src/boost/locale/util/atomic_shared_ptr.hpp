@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_UTIL_ATOMIC_SHARED_PTR_HPP
+#define BOOST_LOCALE_UTIL_ATOMIC_SHARED_PTR_HPP
+
+#include <boost/locale/config.hpp>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+#    define BOOST_LOCALE_HAS_STD_ATOMIC_SHARED_PTR
+#endif
+
+namespace boost { namespace locale { namespace util {
+
+    /// A shared_ptr which can be loaded and replaced concurrently by multiple threads.
+    ///
+    /// Uses std::atomic<std::shared_ptr> if available as the atomic free functions for shared_ptr
+    /// are deprecated since C++20.
+    template<typename T>
+    class atomic_shared_ptr {
+    public:
+        atomic_shared_ptr() = default;
+        explicit atomic_shared_ptr(std::shared_ptr<T> ptr) : ptr_(std::move(ptr)) {}
+        atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+        atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+        std::shared_ptr<T> load() const
+        {
+#ifdef BOOST_LOCALE_HAS_STD_ATOMIC_SHARED_PTR
+            return ptr_.load(std::memory_order_acquire);
+#else
+            return std::atomic_load_explicit(&ptr_, std::memory_order_acquire);
+#endif
+        }
+        void store(std::shared_ptr<T> ptr)
+        {
+#ifdef BOOST_LOCALE_HAS_STD_ATOMIC_SHARED_PTR
+            ptr_.store(std::move(ptr), std::memory_order_release);
+#else
+            std::atomic_store_explicit(&ptr_, std::move(ptr), std::memory_order_release);
+#endif
+        }
+        std::shared_ptr<T> exchange(std::shared_ptr<T> ptr)
+        {
+#ifdef BOOST_LOCALE_HAS_STD_ATOMIC_SHARED_PTR
+            return ptr_.exchange(std::move(ptr), std::memory_order_acq_rel);
+#else
+            return std::atomic_exchange_explicit(&ptr_, std::move(ptr), std::memory_order_acq_rel);
+#endif
+        }
+
+    private:
+#ifdef BOOST_LOCALE_HAS_STD_ATOMIC_SHARED_PTR
+        std::atomic<std::shared_ptr<T>> ptr_;
+#else
+        std::shared_ptr<T> ptr_;
+#endif
+    };
+
+}}} // namespace boost::locale::util
+
+#endif
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "boost/locale/util/c_locale_facets.hpp"
+#include <boost/locale/collator.hpp>
+#include <boost/locale/conversion.hpp>
+#include "boost/locale/shared/mo_hash.hpp"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace boost { namespace locale { namespace util {
+
+    namespace {
+        /// Map a code unit to a value whose order is the code point order of the string
+        template<typename CharType>
+        uint32_t code_point_order(const CharType c)
+        {
+            uint32_t v = static_cast<typename std::make_unsigned<CharType>::type>(c);
+            // UTF-16 surrogates encode code points above all BMP code points
+            if(sizeof(CharType) == 2 && v >= 0xD800)
+                v = (v >= 0xE000) ? v - 0x800 : v + 0x2000;
+            return v;
+        }
+
+        template<typename CharType>
+        bool is_ascii(const CharType* begin, const CharType* end)
+        {
+            for(; begin != end; ++begin) {
+                if(static_cast<typename std::make_unsigned<CharType>::type>(*begin) >= 0x80)
+                    return false;
+            }
+            return true;
+        }
+
+        /// Compares strings by code points, optionally only for the quaternary and identical levels
+        template<typename CharType>
+        class code_point_collator : public collator<CharType> {
+        public:
+            typedef std::basic_string<CharType> string_type;
+
+            /// Use code points for all levels
+            code_point_collator() : lower_levels_(nullptr) {}
+            /// Use the collator of \a base for the primary to tertiary levels
+            explicit code_point_collator(const std::locale& base) :
+                base_(base), lower_levels_(&std::use_facet<collator<CharType>>(base_))
+            {}
+
+        protected:
+            int do_compare(collate_level level,
+                           const CharType* b1,
+                           const CharType* e1,
+                           const CharType* b2,
+                           const CharType* e2) const override
+            {
+                if(uses_lower_levels(level))
+                    return lower_levels_->compare(level, b1, e1, b2, e2);
+                for(; b1 != e1 && b2 != e2; ++b1, ++b2) {
+                    const uint32_t c1 = code_point_order(*b1);
+                    const uint32_t c2 = code_point_order(*b2);
+                    if(c1 != c2)
+                        return (c1 < c2) ? -1 : 1;
+                }
+                if(b2 != e2)
+                    return -1;
+                if(b1 != e1)
+                    return 1;
+                return 0;
+            }
+            string_type do_transform(collate_level level, const CharType* b, const CharType* e) const override
+            {
+                if(uses_lower_levels(level))
+                    return lower_levels_->transform(level, b, e);
+                string_type res(b, e);
+                if(sizeof(CharType) == 2) {
+                    for(CharType& c : res)
+                        c = static_cast<CharType>(code_point_order(c));
+                }
+                return res;
+            }
+            long do_hash(collate_level level, const CharType* b, const CharType* e) const override
+            {
+                if(uses_lower_levels(level))
+                    return lower_levels_->hash(level, b, e);
+                return gnu_gettext::pj_winberger_hash_function(reinterpret_cast<const char*>(b),
+                                                               reinterpret_cast<const char*>(e));
+            }
+
+        private:
+            bool uses_lower_levels(collate_level level) const
+            {
+                return lower_levels_ && level < collate_level::quaternary;
+            }
+
+            std::locale base_;
+            const collator<CharType>* lower_levels_;
+        };
+
+        template<typename CharType>
+        std::locale create_c_collate(const std::locale& in, bool use_installed_for_lower_levels)
+        {
+            if(use_installed_for_lower_levels && std::has_facet<collator<CharType>>(in))
+                return std::locale(in, new code_point_collator<CharType>(in));
+            return std::locale(in, new code_point_collator<CharType>());
+        }
+
+        template<typename CharType>
+        class c_converter : public converter<CharType> {
+        public:
+            typedef std::basic_string<CharType> string_type;
+
+            explicit c_converter(const std::locale& base) :
+                base_(base), impl_(std::use_facet<converter<CharType>>(base_))
+            {}
+
+            string_type
+            convert(converter_base::conversion_type how, const CharType* begin, const CharType* end, int flags = 0)
+              const override
+            {
+                if(how == converter_base::title_case || !is_ascii(begin, end))
+                    return impl_.convert(how, begin, end, flags);
+                string_type res(begin, end);
+                switch(how) {
+                    case converter_base::upper_case:
+                        for(CharType& c : res) {
+                            if(c >= 'a' && c <= 'z')
+                                c -= 'a' - 'A';
+                        }
+                        break;
+                    case converter_base::lower_case:
+                    case converter_base::case_folding:
+                        for(CharType& c : res) {
+                            if(c >= 'A' && c <= 'Z')
+                                c += 'a' - 'A';
+                        }
+                        break;
+                    case converter_base::normalization: // ASCII is invariant under all normalization forms
+                    case converter_base::title_case: break;
+                }
+                return res;
+            }
+
+        private:
+            std::locale base_;
+            const converter<CharType>& impl_;
+        };
+
+        template<typename CharType>
+        std::locale create_c_converter(const std::locale& in)
+        {
+            if(!std::has_facet<converter<CharType>>(in))
+                return in;
+            return std::locale(in, new c_converter<CharType>(in));
+        }
+    } // namespace
+
+    std::locale create_c_collate(const std::locale& in, char_facet_t type, bool use_installed_for_lower_levels)
+    {
+        switch(type) {
+            case char_facet_t::nochar: break;
+            case char_facet_t::char_f: return create_c_collate<char>(in, use_installed_for_lower_levels);
+            case char_facet_t::wchar_f: return create_c_collate<wchar_t>(in, use_installed_for_lower_levels);
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+            case char_facet_t::char16_f: return create_c_collate<char16_t>(in, use_installed_for_lower_levels);
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+            case char_facet_t::char32_f: return create_c_collate<char32_t>(in, use_installed_for_lower_levels);
+#endif
+        }
+        return in;
+    }
+
+    std::locale create_c_converter(const std::locale& in, char_facet_t type)
+    {
+        switch(type) {
+            case char_facet_t::nochar: break;
+            case char_facet_t::char_f: return create_c_converter<char>(in);
+            case char_facet_t::wchar_f: return create_c_converter<wchar_t>(in);
+#ifdef BOOST_LOCALE_ENABLE_CHAR16_T
+            case char_facet_t::char16_f: return create_c_converter<char16_t>(in);
+#endif
+#ifdef BOOST_LOCALE_ENABLE_CHAR32_T
+            case char_facet_t::char32_f: return create_c_converter<char32_t>(in);
+#endif
+        }
+        return in;
+    }
+
+}}} // namespace boost::locale::util
@@ -0,0 +1,26 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_SRC_UTIL_C_LOCALE_FACETS_HPP
+#define BOOST_LOCALE_SRC_UTIL_C_LOCALE_FACETS_HPP
+
+#include <boost/locale/generator.hpp>
+#include <locale>
+
+namespace boost { namespace locale { namespace util {
+
+    /// Install a collator for the C/POSIX locale which compares strings by code points.
+    /// If \a use_installed_for_lower_levels is set, the collator installed in \a in is still used
+    /// for the primary to tertiary levels and only the quaternary and identical levels use code points.
+    std::locale create_c_collate(const std::locale& in, char_facet_t type, bool use_installed_for_lower_levels = false);
+
+    /// Install a converter for the C/POSIX locale which handles ASCII-only text directly.
+    /// Other text and title casing are passed to the converter installed in \a in
+    std::locale create_c_converter(const std::locale& in, char_facet_t type);
+
+}}} // namespace boost::locale::util
+
+#endif
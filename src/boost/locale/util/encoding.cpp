@@ -6,6 +6,7 @@
 // https://www.boost.org/LICENSE_1_0.txt
 
 #include "boost/locale/util/encoding.hpp"
+#include <boost/locale/encoding_errors.hpp>
 #include "boost/locale/util/string.hpp"
 #if BOOST_LOCALE_USE_WIN32_API
 #    include "boost/locale/util/win_codepages.hpp"
@@ -31,6 +32,45 @@ namespace boost { namespace locale { namespace util {
         return result;
     }
 
+    namespace {
+        /// Advance \a it to the next character relevant for a normalized encoding and return it lowercased,
+        /// or return 0 if there is none
+        char next_normalized_char(string_view::const_iterator& it, const string_view::const_iterator end)
+        {
+            for(; it != end; ++it) {
+                const char c = *it;
+                if(is_lower_ascii(c) || is_numeric_ascii(c)) {
+                    ++it;
+                    return c;
+                } else if(is_upper_ascii(c)) {
+                    ++it;
+                    return char(c - 'A' + 'a');
+                }
+            }
+            return 0;
+        }
+    } // namespace
+
+    bool are_encodings_equal(const string_view l, const string_view r)
+    {
+        auto l_it = l.begin(), r_it = r.begin();
+        while(true) {
+            const char c = next_normalized_char(l_it, l.end());
+            if(c != next_normalized_char(r_it, r.end()))
+                return false;
+            if(c == 0)
+                return true;
+        }
+    }
+
+    void check_narrow_encoding(const string_view encoding)
+    {
+        BOOST_LOCALE_START_CONST_CONDITION
+        if(utf8_only && !is_utf8_encoding(encoding) && !are_encodings_equal(encoding, "US-ASCII"))
+            throw conv::invalid_charset_error(encoding.to_string());
+        BOOST_LOCALE_END_CONST_CONDITION
+    }
+
 #if BOOST_LOCALE_USE_WIN32_API
     static int normalized_encoding_to_windows_codepage(const std::string& encoding)
     {
@@ -40,14 +40,30 @@ namespace boost { namespace locale { namespace util {
 
     /// Make encoding lowercase and remove all non-alphanumeric characters
     BOOST_LOCALE_DECL std::string normalize_encoding(string_view encoding);
-    /// True if the normalized encodings are equal
-    inline bool are_encodings_equal(const std::string& l, const std::string& r)
+    /// True if the normalized encodings are equal. Does not allocate.
+    BOOST_LOCALE_DECL bool are_encodings_equal(string_view l, string_view r);
+    /// True if \a encoding is a name of UTF-8. Does not allocate.
+    inline bool is_utf8_encoding(const string_view encoding)
     {
-        return normalize_encoding(l) == normalize_encoding(r);
+        return are_encodings_equal(encoding, "utf8");
     }
 
     BOOST_LOCALE_DECL std::vector<std::string> get_simple_encodings();
 
+#ifdef BOOST_LOCALE_UTF8_ONLY
+    /// True if the library was built to support only UTF-8 as the narrow encoding.
+    /// Facets can then skip checks for and conversions from other encodings.
+    constexpr bool utf8_only = true;
+#else
+    constexpr bool utf8_only = false;
+#endif
+
+    /// Check that \a encoding can be used for the narrow characters of a generated locale
+    ///
+    /// \throws conv::invalid_charset_error: The library is built with \c BOOST_LOCALE_UTF8_ONLY
+    ///   and \a encoding is neither UTF-8 nor US-ASCII
+    BOOST_LOCALE_DECL void check_narrow_encoding(string_view encoding);
+
 #if BOOST_LOCALE_USE_WIN32_API
     int encoding_to_windows_codepage(string_view encoding);
 #else
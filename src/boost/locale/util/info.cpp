@@ -4,10 +4,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 
+#include <boost/locale/encoding.hpp>
 #include <boost/locale/generator.hpp>
 #include <boost/locale/info.hpp>
 #include <boost/locale/util.hpp>
 #include <boost/locale/util/locale_data.hpp>
+#include "boost/locale/util/encoding.hpp"
 #include <cstdlib>
 #include <ios>
 #include <locale>
@@ -18,7 +20,16 @@ namespace boost { namespace locale { namespace util {
 
     class simple_info : public info {
     public:
-        simple_info(const std::string& name, size_t refs = 0) : info(refs), name_(name) { d.parse(name); }
+        simple_info(const std::string& name, size_t refs = 0) : info(refs), name_(name)
+        {
+            d.parse(name);
+            // Only UTF-8 and its subset US-ASCII are allowed and the facets treat both as UTF-8
+            BOOST_LOCALE_START_CONST_CONDITION
+            if(utf8_only && !d.is_utf8())
+                d.encoding("UTF-8");
+            BOOST_LOCALE_END_CONST_CONDITION
+            encoding_id_ = conv::charset_id(d.encoding());
+        }
         std::string get_string_property(string_propery v) const override
         {
             switch(v) {
@@ -35,6 +46,7 @@ namespace boost { namespace locale { namespace util {
         {
             switch(v) {
                 case utf8_property: return d.is_utf8();
+                case encoding_id_property: return encoding_id_;
             }
             return 0;
         }
@@ -42,6 +54,7 @@ namespace boost { namespace locale { namespace util {
     private:
         locale_data d;
         std::string name_;
+        int encoding_id_;
     };
 
     std::locale create_info(const std::locale& in, const std::string& name)
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_LOCALE_UTIL_LAZY_FACETS_HPP
+#define BOOST_LOCALE_UTIL_LAZY_FACETS_HPP
+
+#include <boost/locale/collator.hpp>
+#include <boost/locale/conversion.hpp>
+#include <boost/locale/message.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <functional>
+#include <locale>
+#include <string>
+#include <utility>
+
+namespace boost { namespace locale { namespace util {
+
+    /// Holds a facet of type \a Facet which is created on first use.
+    ///
+    /// The factory returns a locale containing the facet, which is kept alive by this class.
+    /// Creation is thread safe, later accesses don't lock.
+    template<class Facet>
+    class lazy_facet_instance {
+    public:
+        typedef std::function<std::locale()> factory_type;
+
+        explicit lazy_facet_instance(factory_type factory) : factory_(std::move(factory)), facet_(nullptr) {}
+        lazy_facet_instance(const lazy_facet_instance&) = delete;
+        lazy_facet_instance& operator=(const lazy_facet_instance&) = delete;
+
+        const Facet& get() const
+        {
+            const Facet* facet = facet_.load(std::memory_order_acquire);
+            if(BOOST_LIKELY(facet != nullptr))
+                return *facet;
+            boost::unique_lock<boost::mutex> guard(lock_);
+            facet = facet_.load(std::memory_order_relaxed);
+            if(!facet) {
+                locale_ = factory_();
+                facet = &std::use_facet<Facet>(locale_);
+                facet_.store(facet, std::memory_order_release);
+            }
+            return *facet;
+        }
+
+    private:
+        factory_type factory_;
+        mutable std::locale locale_;
+        mutable std::atomic<const Facet*> facet_;
+        mutable boost::mutex lock_;
+    };
+
+    /// Collator forwarding to a collator created on first use
+    template<typename CharType>
+    class lazy_collator : public collator<CharType> {
+    public:
+        typedef std::basic_string<CharType> string_type;
+
+        explicit lazy_collator(typename lazy_facet_instance<collator<CharType>>::factory_type factory) :
+            impl_(std::move(factory))
+        {}
+
+    protected:
+        int do_compare(collate_level level,
+                       const CharType* b1,
+                       const CharType* e1,
+                       const CharType* b2,
+                       const CharType* e2) const override
+        {
+            return impl_.get().compare(level, b1, e1, b2, e2);
+        }
+        string_type do_transform(collate_level level, const CharType* b, const CharType* e) const override
+        {
+            return impl_.get().transform(level, b, e);
+        }
+        long do_hash(collate_level level, const CharType* b, const CharType* e) const override
+        {
+            return impl_.get().hash(level, b, e);
+        }
+
+    private:
+        lazy_facet_instance<collator<CharType>> impl_;
+    };
+
+    /// Converter forwarding to a converter created on first use
+    template<typename CharType>
+    class lazy_converter : public converter<CharType> {
+    public:
+        explicit lazy_converter(typename lazy_facet_instance<converter<CharType>>::factory_type factory) :
+            impl_(std::move(factory))
+        {}
+
+        std::basic_string<CharType> convert(converter_base::conversion_type how,
+                                            const CharType* begin,
+                                            const CharType* end,
+                                            int flags = 0) const override
+        {
+            return impl_.get().convert(how, begin, end, flags);
+        }
+
+    private:
+        lazy_facet_instance<converter<CharType>> impl_;
+    };
+
+    /// Message catalog forwarding to a catalog loaded on first use
+    template<typename CharType>
+    class lazy_message_format : public message_format<CharType> {
+    public:
+        typedef std::basic_string<CharType> string_type;
+
+        explicit lazy_message_format(typename lazy_facet_instance<message_format<CharType>>::factory_type factory) :
+            impl_(std::move(factory))
+        {}
+
+        const CharType* get(int domain_id, const CharType* context, const CharType* id) const override
+        {
+            return impl_.get().get(domain_id, context, id);
+        }
+        const CharType*
+        get(int domain_id, const CharType* context, const CharType* single_id, count_type n) const override
+        {
+            return impl_.get().get(domain_id, context, single_id, n);
+        }
+        int domain(const std::string& domain) const override { return impl_.get().domain(domain); }
+        const CharType* convert(const CharType* msg, string_type& buffer) const override
+        {
+            return impl_.get().convert(msg, buffer);
+        }
+        const detail::compiled_format<CharType>* get_format(const CharType* translation) const override
+        {
+            return impl_.get().get_format(translation);
+        }
+
+    private:
+        lazy_facet_instance<message_format<CharType>> impl_;
+    };
+
+}}} // namespace boost::locale::util
+
+#endif
@@ -158,7 +158,7 @@ namespace boost { namespace locale { namespace util {
             }
         }
         encoding_ = std::move(new_encoding);
-        utf8_ = util::normalize_encoding(encoding_) == "utf8";
+        utf8_ = util::is_utf8_encoding(encoding_);
         return *this;
     }
 
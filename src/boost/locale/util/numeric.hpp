@@ -8,9 +8,11 @@
 #define BOOST_LOCALE_IMPL_UTIL_NUMERIC_HPP
 #include <boost/locale/formatting.hpp>
 #include <boost/locale/info.hpp>
+#include "boost/locale/shared/ios_prop.hpp"
 #include <boost/predef/os.h>
 #include <algorithm>
 #include <cerrno>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <ios>
@@ -18,6 +20,7 @@
 #include <locale>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "timezone.hpp"
@@ -60,6 +63,55 @@ namespace boost { namespace locale { namespace util {
         }
     };
 
+    /// Stream property holding the last date written by base_num_format.
+    ///
+    /// Log output often contains many timestamps of the same second, which can then be written
+    /// without converting and formatting the time again.
+    template<typename CharType>
+    class time_format_cache {
+    public:
+        typedef std::basic_string<CharType> string_type;
+
+        time_format_cache() : valid_(false), time_(), fill_() {}
+        // The cache is not shared with copies of the stream format
+        time_format_cache(const time_format_cache&) : time_format_cache() {}
+        time_format_cache& operator=(const time_format_cache&) = delete;
+
+        void on_imbue() { valid_ = false; }
+
+        /// Get the cached output for these parameters or null if it isn't cached
+        const string_type*
+        get(const std::time_t time, const std::string& time_zone, const string_type& format, const CharType fill) const
+        {
+            if(valid_ && time == time_ && fill == fill_ && format == format_ && time_zone == time_zone_)
+                return &result_;
+            return nullptr;
+        }
+
+        const string_type& set(const std::time_t time,
+                               const std::string& time_zone,
+                               const string_type& format,
+                               const CharType fill,
+                               string_type result)
+        {
+            time_ = time;
+            time_zone_ = time_zone;
+            format_ = format;
+            fill_ = fill;
+            result_ = std::move(result);
+            valid_ = true;
+            return result_;
+        }
+
+    private:
+        bool valid_;
+        std::time_t time_;
+        std::string time_zone_;
+        string_type format_;
+        CharType fill_;
+        string_type result_;
+    };
+
     template<typename CharType>
     class base_num_format : public std::num_put<CharType> {
     public:
@@ -105,6 +157,8 @@ namespace boost { namespace locale { namespace util {
 
             switch(info.display_flags()) {
                 case flags::posix: {
+                    if(put_classic(out, ios, fill, val))
+                        return out;
                     typedef std::basic_ostringstream<CharType> sstream_type;
                     sstream_type ss;
                     ss.imbue(std::locale::classic());
@@ -139,6 +193,123 @@ namespace boost { namespace locale { namespace util {
             return super::do_put(out, ios, fill, val);
         }
 
+        /// Write \a val as the classic locale would into \a buf and return the number of chars written
+        /// or a negative value if the flags aren't supported
+        template<typename ValueType>
+        static typename std::enable_if<std::numeric_limits<ValueType>::is_integer, int>::type
+        to_classic_chars(char* buf, const size_t size, const std::ios_base& ios, ValueType val)
+        {
+            const std::ios_base::fmtflags basefield = ios.flags() & std::ios_base::basefield;
+            if(basefield != std::ios_base::dec && basefield != std::ios_base::fmtflags())
+                return -1;
+            char digits[std::numeric_limits<ValueType>::digits10 + 2]; // Max digits and the sign
+            char* digits_end = digits + sizeof(digits);
+            char* ptr = digits_end;
+            // Avoid overflow for the minimum value of signed types
+            typedef typename std::make_unsigned<ValueType>::type unsigned_type;
+            unsigned_type abs_val = static_cast<unsigned_type>(val);
+            if(val < 0)
+                abs_val = static_cast<unsigned_type>(0) - abs_val;
+            do {
+                *--ptr = static_cast<char>('0' + abs_val % 10);
+                abs_val /= 10;
+            } while(abs_val != 0);
+            if(val < 0)
+                *--ptr = '-';
+            else if(std::numeric_limits<ValueType>::is_signed && (ios.flags() & std::ios_base::showpos))
+                *--ptr = '+';
+            const size_t len = digits_end - ptr;
+            if(len > size)
+                return -1; // LCOV_EXCL_LINE
+            std::copy(ptr, digits_end, buf);
+            return static_cast<int>(len);
+        }
+
+        template<typename ValueType>
+        static typename std::enable_if<!std::numeric_limits<ValueType>::is_integer, int>::type
+        to_classic_chars(char* buf, const size_t size, const std::ios_base& ios, ValueType val)
+        {
+            const std::ios_base::fmtflags flg = ios.flags();
+            char format[16];
+            char* fptr = format;
+            *fptr++ = '%';
+            if(flg & std::ios_base::showpos)
+                *fptr++ = '+';
+            if(flg & std::ios_base::showpoint)
+                *fptr++ = '#';
+            *fptr++ = '.';
+            *fptr++ = '*';
+            if(std::is_same<ValueType, long double>::value)
+                *fptr++ = 'L';
+            const bool uppercase = (flg & std::ios_base::uppercase) != 0;
+            const std::ios_base::fmtflags floatfield = flg & std::ios_base::floatfield;
+            if(floatfield == std::ios_base::fixed)
+                *fptr++ = 'f';
+            else if(floatfield == std::ios_base::scientific)
+                *fptr++ = uppercase ? 'E' : 'e';
+            else if(floatfield == std::ios_base::fmtflags())
+                *fptr++ = uppercase ? 'G' : 'g';
+            else
+                return -1; // Hexfloat
+            *fptr = '\0';
+            const int precision = ios.precision() < 0 ? 6 : static_cast<int>(ios.precision());
+            const int len = std::snprintf(buf, size, format, precision, val);
+            if(len < 0 || static_cast<size_t>(len) >= size)
+                return -1;
+            // The decimal point depends on the global C locale, replace it by the one of the classic locale
+            int out_len = 0;
+            bool in_decimal_point = false;
+            for(int i = 0; i < len; i++) {
+                const char c = buf[i];
+                if(('0' <= c && c <= '9') || c == '+' || c == '-' || ('a' <= (c | 0x20) && (c | 0x20) <= 'z')) {
+                    buf[out_len++] = c;
+                    in_decimal_point = false;
+                } else if(!in_decimal_point) {
+                    buf[out_len++] = '.';
+                    in_decimal_point = true;
+                }
+            }
+            return out_len;
+        }
+
+        /// Write \a val as the classic locale would, which is what the posix flag requests.
+        /// Return false if the flags aren't supported
+        template<typename ValueType>
+        bool put_classic(iter_type& out, std::ios_base& ios, CharType fill, ValueType val) const
+        {
+            char buf[128];
+            const int len = to_classic_chars(buf, sizeof(buf), ios, val);
+            if(len < 0)
+                return false;
+            std::streamsize on_left = 0, on_internal = 0, on_right = 0;
+            if(len < ios.width()) {
+                const std::streamsize n = ios.width() - len;
+                switch(ios.flags() & std::ios_base::adjustfield) {
+                    case std::ios_base::left: on_right = n; break;
+                    case std::ios_base::internal:
+                        if(buf[0] == '-' || buf[0] == '+')
+                            on_internal = n;
+                        else
+                            on_left = n;
+                        break;
+                    default: on_left = n;
+                }
+            }
+            for(; on_left > 0; on_left--)
+                *out++ = fill;
+            int i = 0;
+            if(on_internal > 0)
+                *out++ = CharType(buf[i++]);
+            for(; on_internal > 0; on_internal--)
+                *out++ = fill;
+            for(; i < len; i++)
+                *out++ = CharType(buf[i]);
+            for(; on_right > 0; on_right--)
+                *out++ = fill;
+            ios.width(0);
+            return true;
+        }
+
         virtual iter_type
         do_format_currency(bool intl, iter_type out, std::ios_base& ios, CharType fill, long double val) const
         {
@@ -172,10 +343,12 @@ namespace boost { namespace locale { namespace util {
             return format_time(out, ios, fill, time, fmt);
         }
 
-        iter_type
-        format_time(iter_type out, std::ios_base& ios, CharType fill, std::time_t time, const string_type& format) const
+        static string_type render_time(std::ios_base& ios,
+                                       CharType fill,
+                                       std::time_t time,
+                                       const std::string& tz,
+                                       const string_type& format)
         {
-            std::string tz = ios_info::get(ios).time_zone();
             std::tm tm;
 #if BOOST_OS_LINUX || BOOST_OS_BSD_FREE || defined(__APPLE__)
             std::vector<char> tmp_buf(tz.c_str(), tz.c_str() + tz.size() + 1);
@@ -209,7 +382,17 @@ namespace boost { namespace locale { namespace util {
             std::basic_ostringstream<CharType> tmp_out;
             std::use_facet<std::time_put<CharType>>(ios.getloc())
               .put(tmp_out, tmp_out, fill, &tm, format.c_str(), format.c_str() + format.size());
-            string_type str = tmp_out.str();
+            return tmp_out.str();
+        }
+
+        iter_type
+        format_time(iter_type out, std::ios_base& ios, CharType fill, std::time_t time, const string_type& format) const
+        {
+            const std::string tz = ios_info::get(ios).time_zone();
+            time_format_cache<CharType>& cache = impl::ios_prop<time_format_cache<CharType>>::get(ios);
+            const string_type* cached_str = cache.get(time, tz, format, fill);
+            const string_type& str =
+              cached_str ? *cached_str : cache.set(time, tz, format, fill, render_time(ios, fill, time, tz, format));
             std::streamsize on_left = 0, on_right = 0;
             std::streamsize points = formatting_size_traits<CharType>::size(str, ios.getloc());
             if(points < ios.width()) {
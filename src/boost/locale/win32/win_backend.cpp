@@ -11,6 +11,7 @@
 #include <boost/locale/localization_backend.hpp>
 #include <boost/locale/util.hpp>
 #include <boost/locale/util/locale_data.hpp>
+#include "boost/locale/util/c_locale_facets.hpp"
 #include "boost/locale/util/gregorian.hpp"
 #include "boost/locale/util/make_std_unique.hpp"
 #include "boost/locale/win32/all_generator.hpp"
@@ -70,8 +71,12 @@ namespace boost { namespace locale { namespace impl_win {
             prepare_data();
 
             switch(category) {
-                case category_t::convert: return create_convert(base, lc_, type);
-                case category_t::collation: return create_collate(base, lc_, type);
+                case category_t::convert: {
+                    const std::locale res = create_convert(base, lc_, type);
+                    return lc_.is_c() ? util::create_c_converter(res, type) : res;
+                }
+                case category_t::collation:
+                    return lc_.is_c() ? util::create_c_collate(base, type) : create_collate(base, lc_, type);
                 case category_t::formatting: return create_formatting(base, lc_, type);
                 case category_t::parsing: return create_parsing(base, lc_, type);
                 case category_t::calendar: {
@@ -36,6 +36,13 @@ bool hasWinCodepage(unsigned)
 }
 #endif
 
+/// False if the library was built to support only UTF-8 as the narrow encoding of generated locales
+#ifdef BOOST_LOCALE_UTF8_ONLY
+constexpr bool has_legacy_encodings = false;
+#else
+constexpr bool has_legacy_encodings = true;
+#endif
+
 #if defined(BOOST_MSVC) && BOOST_MSVC < 1700
 #    pragma warning(disable : 4428) // universal-character-name encountered in source
 #endif
@@ -302,8 +302,10 @@ void test_boundaries(std::string* all, int* first, int* second, lb::boundary_typ
     boost::locale::generator g;
     std::cout << " char UTF-8" << std::endl;
     run_word<char>(all, first, second, nullptr, nullptr, nullptr, g("he_IL.UTF-8"), t);
+#ifndef BOOST_LOCALE_UTF8_ONLY
     std::cout << " char CP1255" << std::endl;
     run_word<char>(all, first, second, nullptr, nullptr, nullptr, g("he_IL.cp1255"), t);
+#endif
     std::cout << " wchar_t" << std::endl;
     run_word<wchar_t>(all, first, second, nullptr, nullptr, nullptr, g("he_IL.UTF-8"), t);
 #ifdef BOOST_LOCALE_ENABLE_CHAR16_T
@@ -354,11 +356,13 @@ void word_boundary()
     run_word<char>(txt_simple, none_simple, zero, word_simple, zero, zero, utf8_en_locale);
     run_word<char>(txt_all, none_all, num_all, word_all, kana_all, ideo_all, utf8_jp_locale);
 
+#ifndef BOOST_LOCALE_UTF8_ONLY
     std::cout << " char Shift-JIS" << std::endl;
     const std::locale sjis_jp_locale = g("ja_JP.SJIS");
     run_word<char>(txt_empty, zero, zero, zero, zero, zero, sjis_jp_locale);
     run_word<char>(txt_simple, none_simple, zero, word_simple, zero, zero, sjis_jp_locale);
     run_word<char>(txt_all, none_all, num_all, word_all, kana_all, ideo_all, sjis_jp_locale);
+#endif
 
     std::cout << " wchar_t" << std::endl;
     run_word<wchar_t>(txt_empty, zero, zero, zero, zero, zero, utf8_en_locale);
@@ -20,6 +20,8 @@ void test_comp(const std::locale& l,
 {
     typedef std::basic_string<Char> string_type;
     TEST_EQ(boost::locale::comparator<Char>(l, level)(left, right), expected < 0);
+    TEST_EQ(boost::locale::comparator<Char>(boost::locale::collator_handle<Char>(l), level)(left, right),
+            expected < 0);
     if(level == boost::locale::collate_level::identical) {
         const std::collate<Char>& coll = std::use_facet<std::collate<Char>>(l);
         string_type lt = coll.transform(left.c_str(), left.c_str() + left.size());
@@ -78,10 +80,12 @@ void compare(const std::string left,
 #ifdef BOOST_LOCALE_ENABLE_CHAR32_T
     TEST_COMP(char32_t, to<char32_t>(left), to<char32_t>(right));
 #endif
+#ifndef BOOST_LOCALE_UTF8_ONLY
     l = gen("en_US.ISO8859-1");
     if(level == collate_level::identical)
         TEST_EQ(l(to<char>(left), to<char>(right)), (expected < 0));
     TEST_COMP(char, to<char>(left), to<char>(right));
+#endif
 }
 
 void test_collate()
@@ -108,9 +112,19 @@ void test_collate()
     compare("ä", "ä", collate_level::identical, eq);
 }
 
+void test_lazy_comparator()
+{
+    // The collator is only required when comparing, so the comparator can be created for any locale
+    const boost::locale::comparator<char> comp(std::locale::classic());
+    const boost::locale::comparator<char> copy = comp;
+    TEST_THROWS(comp("a", "b"), std::bad_cast);
+    TEST_THROWS(copy("a", "b"), std::bad_cast);
+}
+
 BOOST_LOCALE_DISABLE_UNREACHABLE_CODE_WARNING
 void test_main(int /*argc*/, char** /*argv*/)
 {
+    test_lazy_comparator();
 #ifndef BOOST_LOCALE_WITH_ICU
     std::cout << "ICU is not build... Skipping\n";
     return;
@@ -7,6 +7,7 @@
 
 #include <boost/locale/encoding.hpp>
 #include <boost/locale/generator.hpp>
+#include <boost/locale/util.hpp>
 #include <algorithm>
 
 #include "boostLocale/test/tools.hpp"
@@ -138,10 +139,12 @@ void test_error_to_utf(std::string source, std::basic_string<Char> target, std::
     TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), encoding, stop));
     TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), source.c_str() + source.size(), encoding, stop));
     // Same but encoding via locale
-    const std::locale l = boost::locale::generator{}("en_US." + encoding);
-    TEST_FAIL_CONVERSION(to_utf<Char>(source, l, stop));
-    TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), l, stop));
-    TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), source.c_str() + source.size(), l, stop));
+    if(has_legacy_encodings || boost::locale::conv::charset_id(encoding) == boost::locale::conv::utf8_charset_id) {
+        const std::locale l = boost::locale::generator{}("en_US." + encoding);
+        TEST_FAIL_CONVERSION(to_utf<Char>(source, l, stop));
+        TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), l, stop));
+        TEST_FAIL_CONVERSION(to_utf<Char>(source.c_str(), source.c_str() + source.size(), l, stop));
+    }
     test_to_utf_for_impls(source, target, encoding, false);
 }
 
@@ -159,10 +162,12 @@ void test_error_from_utf(std::basic_string<Char> source, std::string target, std
     TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), encoding, stop));
     TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), source.c_str() + source.size(), encoding, stop));
     // Same but encoding via locale
-    const std::locale l = boost::locale::generator{}("en_US." + encoding);
-    TEST_FAIL_CONVERSION(from_utf<Char>(source, l, stop));
-    TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), l, stop));
-    TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), source.c_str() + source.size(), l, stop));
+    if(has_legacy_encodings || boost::locale::conv::charset_id(encoding) == boost::locale::conv::utf8_charset_id) {
+        const std::locale l = boost::locale::generator{}("en_US." + encoding);
+        TEST_FAIL_CONVERSION(from_utf<Char>(source, l, stop));
+        TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), l, stop));
+        TEST_FAIL_CONVERSION(from_utf<Char>(source.c_str(), source.c_str() + source.size(), l, stop));
+    }
     test_from_utf_for_impls(source, target, encoding, false);
 }
 
@@ -424,11 +429,13 @@ void test_latin1_conversions_for()
     TEST_EQ(utf_encoder<Char>(encoding)(sLatin1), sWide);
     TEST_EQ(utf_encoder<Char>(encoding).convert(sLatin1), sWide);
     TEST_EQ(utf_encoder<Char>(encoding).convert(sLatin1.c_str(), sLatin1.c_str() + sLatin1.size()), sWide);
+#ifndef BOOST_LOCALE_UTF8_ONLY
     // Same but encoding given via locale
     const std::locale l = boost::locale::generator{}("en_US.Latin1");
     TEST_EQ(to_utf<Char>(sLatin1, l), sWide);
     TEST_EQ(to_utf<Char>(sLatin1.c_str(), l), sWide);
     TEST_EQ(to_utf<Char>(sLatin1.c_str(), sLatin1.c_str() + sLatin1.size(), l), sWide);
+#endif
 
     using boost::locale::conv::from_utf;
     using boost::locale::conv::utf_decoder;
@@ -439,10 +446,12 @@ void test_latin1_conversions_for()
     TEST_EQ(utf_decoder<Char>(encoding)(sWide), sLatin1);
     TEST_EQ(utf_decoder<Char>(encoding).convert(sWide), sLatin1);
     TEST_EQ(utf_decoder<Char>(encoding).convert(sWide.c_str(), sWide.c_str() + sWide.size()), sLatin1);
+#ifndef BOOST_LOCALE_UTF8_ONLY
     // Same but encoding given via locale
     TEST_EQ(from_utf<Char>(sWide, l), sLatin1);
     TEST_EQ(from_utf<Char>(sWide.c_str(), l), sLatin1);
     TEST_EQ(from_utf<Char>(sWide.c_str(), sWide.c_str() + sWide.size(), l), sLatin1);
+#endif
 
     // Empty string doesn't error/assert
     TEST_EQ(to_utf<Char>("", encoding), utf<Char>(""));
@@ -571,6 +580,7 @@ void test_between()
 void test_utf_name();
 void test_simple_encodings();
 void test_win_codepages();
+void test_encoding_comparison();
 
 void test_main(int /*argc*/, char** /*argv*/)
 {
@@ -583,6 +593,7 @@ void test_main(int /*argc*/, char** /*argv*/)
     test_utf_name();
     test_simple_encodings();
     test_win_codepages();
+    test_encoding_comparison();
 
     test_latin1_conversions();
     test_utf_to_utf();
@@ -654,6 +665,44 @@ void test_simple_encodings()
         std::cerr << "First wrongly sorted element: " << *it << '\n'; // LCOV_EXCL_LINE
 }
 
+void test_encoding_comparison()
+{
+    using namespace boost::locale::util;
+    TEST(are_encodings_equal("UTF-8", "utf8"));
+    TEST(are_encodings_equal("ISO-8859-1", "iso8859_1"));
+    TEST(are_encodings_equal("", "-"));
+    TEST(!are_encodings_equal("UTF-8", "UTF-16"));
+    TEST(!are_encodings_equal("UTF-8", "UTF"));
+    TEST(!are_encodings_equal("latin1", "latin"));
+    TEST(is_utf8_encoding("UTF-8"));
+    TEST(is_utf8_encoding("Utf8"));
+    TEST(!is_utf8_encoding("UTF-16"));
+
+    using boost::locale::conv::charset_id;
+    using boost::locale::conv::utf8_charset_id;
+    TEST_EQ(charset_id("UTF-8"), utf8_charset_id);
+    TEST_EQ(charset_id("utf8"), utf8_charset_id);
+    TEST_EQ(charset_id("ISO-8859-1"), charset_id("iso8859_1"));
+    TEST_EQ(charset_id("latin1"), charset_id("ISO-8859-1"));
+    TEST_EQ(charset_id("CP1252"), charset_id("windows-1252"));
+    TEST_NE(charset_id("ISO-8859-1"), charset_id("ISO-8859-15"));
+    TEST_NE(charset_id("ISO-8859-1"), 0);
+    TEST_NE(charset_id("ISO-8859-1"), utf8_charset_id);
+    TEST_EQ(charset_id("UTF-16"), 0);
+    TEST_EQ(charset_id(""), 0);
+
+    using boost::locale::info;
+    const std::locale utf8_locale = create_info(std::locale::classic(), "en_US.UTF-8");
+    TEST_EQ(std::use_facet<info>(utf8_locale).encoding_id(), utf8_charset_id);
+    TEST_EQ(boost::locale::conv::to_utf<wchar_t>("\xc3\xa4", utf8_locale), L"\u00e4");
+    TEST_EQ(boost::locale::conv::from_utf(L"\u00e4", utf8_locale), "\xc3\xa4");
+    if(!utf8_only) {
+        const std::locale latin1_locale = create_info(std::locale::classic(), "en_US.ISO-8859-1");
+        TEST_EQ(std::use_facet<info>(latin1_locale).encoding_id(), charset_id("latin1"));
+        TEST_EQ(std::use_facet<info>(create_info(std::locale::classic(), "de_DE.x-unknown")).encoding_id(), 0);
+    }
+}
+
 void test_win_codepages()
 {
     using namespace boost::locale::util;
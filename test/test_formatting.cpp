@@ -8,9 +8,12 @@
 #include <boost/locale/date_time.hpp>
 #include <boost/locale/encoding_utf.hpp>
 #include <boost/locale/format.hpp>
+#include <boost/locale/format_values.hpp>
 #include <boost/locale/formatting.hpp>
 #include <boost/locale/generator.hpp>
 #include <boost/locale/localization_backend.hpp>
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <ctime>
 #include <iomanip>
@@ -18,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "boostLocale/test/tools.hpp"
 #include "boostLocale/test/unit_test.hpp"
@@ -122,11 +126,34 @@ std::string get_ICU_datetime(format_style_t style, const time_t ts)
     return from_icu_string(fmt->format(ts * 1000., s));
 }
 
+std::string get_icu_number(const char* locale, const int32_t value)
+{
+    UErrorCode err = U_ZERO_ERROR;
+    std::unique_ptr<icu::NumberFormat> fmt(icu::NumberFormat::createInstance(icu::Locale(locale), err));
+    TEST_REQUIRE(U_SUCCESS(err) && fmt.get());
+
+    icu::UnicodeString tmp;
+    return from_icu_string(fmt->format(value, tmp));
+}
+
+std::string get_icu_number(const char* locale, const double value, const int precision, const bool fixed)
+{
+    UErrorCode err = U_ZERO_ERROR;
+    std::unique_ptr<icu::NumberFormat> fmt(icu::NumberFormat::createInstance(icu::Locale(locale), err));
+    TEST_REQUIRE(U_SUCCESS(err) && fmt.get());
+    fmt->setMaximumFractionDigits(precision);
+    fmt->setMinimumFractionDigits(fixed ? precision : 0);
+
+    icu::UnicodeString tmp;
+    return from_icu_string(fmt->format(value, tmp));
+}
+
 #else
 const std::string icu_full_gmt_name;
 // clang-format off
 std::string get_ICU_time(...){ return ""; } // LCOV_EXCL_LINE
 std::string get_ICU_datetime(...){ return ""; } // LCOV_EXCL_LINE
+std::string get_icu_number(...){ return ""; } // LCOV_EXCL_LINE
 // clang-format on
 #endif
 
@@ -334,6 +361,16 @@ void test_as_posix(const std::string& e_charset = "UTF-8")
             TEST_FMT_PARSE_1(as::posix, 1.25f, "1.25");
             TEST_FMT_PARSE_1(as::posix, -4.57, "-4.57");
             TEST_FMT_PARSE_1(as::posix, 3.815l, "3.815");
+
+            TEST_FMT(as::posix << std::setw(6), -42, "   -42");
+            TEST_FMT(as::posix << std::setw(6) << std::left, -42, "-42   ");
+            TEST_FMT(as::posix << std::setw(6) << std::internal, -42, "-   42");
+            TEST_FMT(as::posix << std::showpos, 42, "+42");
+            TEST_FMT(as::posix << std::showpos, 42u, "42");
+            TEST_FMT(as::posix << std::hex, 255, "ff");
+            TEST_FMT(as::posix << std::fixed << std::setprecision(2), 1234.5, "1234.50");
+            TEST_FMT(as::posix << std::scientific << std::uppercase << std::setprecision(1), 1234.5, "1.2E+03");
+            TEST_FMT(as::posix << std::showpoint << std::setprecision(3), 2.0, "2.00");
         }
     }
     localization_backend_manager::global(orig_backend);
@@ -576,6 +613,11 @@ void test_manip(std::string e_charset = "UTF-8")
         empty_stream(ss) << as::ftime(format_string) << as::gmt << now;
         strftime(time_str, sizeof(time_str), format.c_str(), gmtime_wrap(&now));
         TEST_EQ(ss.str(), to<CharType>(time_str));
+        // Unknown zones behave like GMT, also when used again
+        for(int i = 0; i < 2; i++) {
+            empty_stream(ss) << as::ftime(format_string) << as::time_zone("Invalid/Zone") << now;
+            TEST_EQ(ss.str(), to<CharType>(time_str));
+        }
     }
     const std::pair<std::string, std::string> format_string_test_cases[] = {
       std::make_pair("Now is %A, %H o'clo''ck ' or not ' ", "Now is Thursday, 15 o'clo''ck ' or not ' "),
@@ -609,6 +651,279 @@ std::basic_string<CharType> do_format(const std::locale& loc, const char (&fmt_s
     return do_format(loc, ascii_to<CharType>(fmt_str), std::forward<Ts>(ts)...);
 }
 
+template<typename T>
+std::string format_number(const std::locale& loc, T value, std::ios_base::fmtflags floatfield = {}, int precision = 6)
+{
+    std::ostringstream ss;
+    ss.imbue(loc);
+    ss.setf(floatfield, std::ios_base::floatfield);
+    ss << boost::locale::as::number << std::setprecision(precision) << value;
+    return ss.str();
+}
+
+void test_integral_numbers()
+{
+    std::cout << "Testing integral numbers" << std::endl;
+    const std::locale en = boost::locale::generator()("en_US.UTF-8");
+    TEST_EQ(format_number(en, 0), "0");
+    TEST_EQ(format_number(en, 123), "123");
+    TEST_EQ(format_number(en, -1234567), "-1,234,567");
+    TEST_EQ(format_number(en, std::numeric_limits<long long>::min()), "-9,223,372,036,854,775,808");
+    TEST_EQ(format_number(en, 1234.0), "1,234");
+    TEST_EQ(format_number(en, 1234.0, std::ios_base::fixed, 2), "1,234.00");
+    TEST_EQ(format_number(en, -0.0), "-0");
+    TEST_EQ(format_number(en, 1234.5), "1,234.5");
+    TEST_EQ(format_number(en, 1e20), "100,000,000,000,000,000,000");
+    const std::locale hi = boost::locale::generator()("hi_IN.UTF-8");
+    TEST_EQ(format_number(hi, 1234567), "12,34,567");
+    const std::locale ar = boost::locale::generator()("ar_EG.UTF-8");
+    // Arabic-Indic or Latin digits depending on the ICU version
+    TEST_EQ(format_number(ar, 12), get_icu_number("ar_EG", 12));
+    TEST_EQ(format_number(ar, -1234567), get_icu_number("ar_EG", -1234567));
+}
+
+void test_fractional_numbers()
+{
+    std::cout << "Testing fractional numbers" << std::endl;
+    const std::locale en = boost::locale::generator()("en_US.UTF-8");
+    TEST_EQ(format_number(en, 1234.5678, std::ios_base::fixed, 2), "1,234.57");
+    TEST_EQ(format_number(en, 0.5, std::ios_base::fixed, 3), "0.500");
+    TEST_EQ(format_number(en, 12.0625), "12.0625");
+    // ICU rounds the shortest representation "2.675", not the exact value slightly below
+    TEST_EQ(format_number(en, 2.675, std::ios_base::fixed, 2), "2.68");
+    TEST_EQ(format_number(en, -0.0001, std::ios_base::fixed, 2), get_icu_number("en_US", -0.0001, 2, true));
+    const std::locale de = boost::locale::generator()("de_DE.UTF-8");
+    TEST_EQ(format_number(de, -1234.5678, std::ios_base::fixed, 2), "-1.234,57");
+
+    const double values[] = {0.1,     -0.25,       3.14159265358979, 1234.5,     -98765.4321, 0.1 + 0.2, 2.675,
+                             1.005,   1e-5,        999.9999,         -0.000499,  12345678.125, 1.0 / 3, 0.045,
+                             1e14 + 0.5, 5e-324, 123456789.987654321};
+    const char* const locales[] = {"en_US", "de_DE", "hi_IN", "ar_EG"};
+    for(const char* name : locales) {
+        const std::locale loc = boost::locale::generator()(std::string(name) + ".UTF-8");
+        for(const double value : values) {
+            for(const int precision : {0, 2, 3, 6, 15}) {
+                TEST_EQ(format_number(loc, value, {}, precision), get_icu_number(name, value, precision, false));
+                TEST_EQ(format_number(loc, value, std::ios_base::fixed, precision),
+                        get_icu_number(name, value, precision, true));
+            }
+        }
+    }
+}
+
+template<typename T, typename CharType>
+T parse_number(const std::locale& loc, const std::basic_string<CharType>& str, std::basic_string<CharType>& rest)
+{
+    std::basic_istringstream<CharType> ss(str);
+    ss.imbue(loc);
+    T value{};
+    ss >> as::number >> value;
+    rest.clear();
+    if(ss.fail())
+        rest = ascii_to<CharType>("FAIL");
+    else
+        std::getline(ss, rest);
+    return value;
+}
+
+template<typename CharType>
+void test_parse_numbers_impl()
+{
+    using string_type = std::basic_string<CharType>;
+    const std::locale en = boost::locale::generator()("en_US.UTF-8");
+    string_type rest;
+    TEST_EQ(parse_number<int>(en, ascii_to<CharType>("12345"), rest), 12345);
+    TEST(rest.empty());
+    TEST_EQ(parse_number<double>(en, ascii_to<CharType>("-3.25 x"), rest), -3.25);
+    TEST(rest == ascii_to<CharType>(" x"));
+    TEST_EQ(parse_number<long long>(en, ascii_to<CharType>("-1,234,567\t8"), rest), -1234567);
+    TEST(rest == ascii_to<CharType>("\t8"));
+    TEST_EQ(parse_number<double>(en, ascii_to<CharType>("0.1"), rest), 0.1);
+    TEST(std::signbit(parse_number<double>(en, ascii_to<CharType>("-0"), rest)));
+    // Handled by ICU
+    TEST_EQ(parse_number<long long>(en, ascii_to<CharType>("12 34"), rest), 0);
+    TEST(rest == ascii_to<CharType>("FAIL"));
+    TEST_EQ(parse_number<int>(en, ascii_to<CharType>("1 234"), rest), 1234);
+    TEST_EQ(parse_number<double>(en, ascii_to<CharType>("1e5"), rest), 1e5);
+    TEST_EQ(parse_number<int>(en, ascii_to<CharType>("3.75"), rest), 3);
+    TEST_EQ(parse_number<double>(en, ascii_to<CharType>("1234567890.1234567"), rest), 1234567890.1234567);
+    TEST_EQ(parse_number<long long>(en, ascii_to<CharType>("9223372036854775807"), rest),
+            std::numeric_limits<long long>::max());
+    parse_number<int>(en, ascii_to<CharType>("2147483648"), rest);
+    TEST(rest == ascii_to<CharType>("FAIL"));
+
+    const std::locale de = boost::locale::generator()("de_DE.UTF-8");
+    TEST_EQ(parse_number<double>(de, ascii_to<CharType>("-1.234,5"), rest), -1234.5);
+    TEST_EQ(parse_number<double>(de, ascii_to<CharType>("3,25;"), rest), 3.25);
+    TEST(rest == ascii_to<CharType>(";"));
+    TEST_EQ(parse_number<double>(de, ascii_to<CharType>("-3.25"), rest), 0);
+    TEST(rest == ascii_to<CharType>("FAIL"));
+    const std::locale hi = boost::locale::generator()("hi_IN.UTF-8");
+    TEST_EQ(parse_number<int>(hi, ascii_to<CharType>("12,34,567"), rest), 1234567);
+    TEST(rest.empty());
+}
+
+void test_parse_numbers()
+{
+    std::cout << "Testing parsing numbers" << std::endl;
+    test_parse_numbers_impl<char>();
+    test_parse_numbers_impl<wchar_t>();
+}
+
+/// Writes its text and then fails if requested
+struct failing_value {
+    std::string text;
+    bool fail;
+};
+std::ostream& operator<<(std::ostream& out, const failing_value& value)
+{
+    out << value.text;
+    if(value.fail)
+        out.setstate(std::ios_base::failbit);
+    return out;
+}
+
+void test_format_values()
+{
+    std::cout << "Testing bulk formatting" << std::endl;
+    using namespace boost::locale;
+    const std::locale loc = generator()("en_US.UTF-8");
+    std::ostringstream format;
+    format.imbue(loc);
+    format << as::number << std::fixed << std::setprecision(1) << std::setw(8);
+    const std::vector<double> numbers = {1.5, -1234.25, 1e6};
+    string_arena result = format_values(format, numbers.begin(), numbers.end());
+    TEST_EQ(result.size(), 3u);
+    TEST_EQ(result[0], "     1.5");
+    TEST_EQ(result[1], "-1,234.2");
+    TEST_EQ(result[2], "1,000,000.0");
+    TEST_EQ(result.buffer(), "     1.5-1,234.21,000,000.0");
+    // The format is not modified
+    TEST_EQ(format.width(), 8);
+    TEST(format.str().empty());
+
+    format.str("");
+    format.width(0);
+    format << as::ftime("%Y-%m-%d %H:%M:%S") << as::time_zone("GMT+01:00");
+    const std::vector<time_t> times = {0, 86400 + 3600, 86400 + 3601};
+    result.clear();
+    result.append(format, times.begin(), times.end());
+    result.append(format, times.begin(), times.begin() + 1);
+    TEST_EQ(result.size(), 4u);
+    TEST_EQ(result[0], "1970-01-01 01:00:00");
+    TEST_EQ(result[1], "1970-01-02 02:00:00");
+    TEST_EQ(result[2], "1970-01-02 02:00:01");
+    TEST_EQ(result[3], "1970-01-01 01:00:00");
+    TEST_EQ(result.offsets().back(), result.buffer().size());
+
+    std::wostringstream wformat;
+    wformat.imbue(loc);
+    wformat << as::percent;
+    const double ratio[] = {0.25};
+    TEST(format_values(wformat, ratio, ratio + 1)[0] == L"25%");
+
+    // The partial output of a failing value is removed
+    const std::vector<failing_value> values = {{"a", false}, {"b", true}, {"c", false}};
+    format.str("");
+    result.clear();
+    TEST_EQ(result.append(format, values.begin(), values.end()), 1u);
+    TEST_EQ(result.size(), 1u);
+    TEST_EQ(result.buffer(), "a");
+    format.exceptions(std::ios_base::failbit);
+    TEST_THROWS(result.append(format, values.begin() + 1, values.end()), std::ios_base::failure);
+    TEST_EQ(result.size(), 1u);
+    TEST_EQ(result.buffer(), "a");
+    format.exceptions(std::ios_base::goodbit);
+
+    const format_template tmpl("[{1}]");
+    const std::vector<std::locale> locales{loc, loc};
+    TEST_EQ(tmpl.render_all(locales, values[0]).buffer(), "[a][a]");
+    TEST_THROWS(tmpl.render_all(locales, values[1]), std::ios_base::failure);
+
+#ifdef BOOST_LOCALE_WITH_ICU
+    // Without a time zone the default one at the time of formatting is used
+    const std::string old_time_zone = time_zone::global("");
+    std::ostringstream local_format;
+    local_format.imbue(loc);
+    local_format << as::ftime("%H:%M");
+    const time_t midnight = 0;
+    std::unique_ptr<icu::TimeZone> old_default(icu::TimeZone::createDefault());
+    icu::TimeZone::adoptDefault(icu::TimeZone::createTimeZone("GMT+01:00"));
+    TEST_EQ(format_values(local_format, &midnight, &midnight + 1)[0], "01:00");
+    icu::TimeZone::adoptDefault(icu::TimeZone::createTimeZone("GMT+02:00"));
+    TEST_EQ(format_values(local_format, &midnight, &midnight + 1)[0], "02:00");
+    icu::TimeZone::adoptDefault(old_default.release());
+    time_zone::global(old_time_zone);
+#endif
+}
+
+void test_stream_formatter_reuse()
+{
+    std::cout << "Testing reuse of stream formatters" << std::endl;
+    using namespace boost::locale;
+    const std::locale loc = generator()("en_US.UTF-8");
+    std::ostringstream ss1, ss2;
+    ss1.imbue(loc);
+    ss2.imbue(loc);
+    ss1 << as::number << std::fixed << std::setprecision(1);
+    ss2 << as::number << std::fixed << std::setprecision(3);
+    // Interleaved use of streams with different settings
+    for(int i = 0; i < 2; ++i) {
+        ss1 << 1.5 << ' ';
+        ss2 << 1.5 << ' ';
+    }
+    TEST_EQ(ss1.str(), "1.5 1.5 ");
+    TEST_EQ(ss2.str(), "1.500 1.500 ");
+    // Changes to the stream are picked up
+    ss1 << std::setprecision(2) << 1.5 << ' ' << as::percent << 0.5 << ' ' << as::currency << 2 << ' ';
+    TEST_EQ(ss1.str(), "1.5 1.5 1.50 50.00% $2.00 ");
+    ss1.str("");
+    ss1.imbue(generator()("de_DE.UTF-8"));
+    ss1 << as::number << 1.5;
+    TEST_EQ(ss1.str(), "1,50");
+    // Copies of the format use the same settings
+    ss2.str("");
+    ss2.copyfmt(ss1);
+    ss2 << 1.5;
+    TEST_EQ(ss2.str(), "1,50");
+    ss1.str("");
+    ss1 << 1.5;
+    TEST_EQ(ss1.str(), "1,50");
+    // Formats with the same settings are shared, parsing must not be affected by that
+    std::istringstream ss3("2.25");
+    ss3.imbue(loc);
+    double value = 0;
+    ss3 >> as::number >> std::fixed >> std::setprecision(1) >> value;
+    TEST_EQ(value, 2.25);
+    ss2.str("");
+    ss2.imbue(loc);
+    ss2 << as::number << std::fixed << std::setprecision(1) << value;
+    TEST_EQ(ss2.str(), "2.2");
+    // The formats are shared by all locales with the same name but not with other locales,
+    // also after more formats were used than fit into the cache
+    for(int precision = 0; precision < 40; ++precision) {
+        std::ostringstream classic_ss;
+        classic_ss.imbue(std::locale::classic());
+        classic_ss << std::fixed << std::setprecision(precision) << 1.5;
+        std::string expected = classic_ss.str();
+        for(const char* name : {"en_US.UTF-8", "de_DE.UTF-8"}) {
+            ss2.str("");
+            ss2.imbue(generator()(name));
+            ss2 << as::number << std::fixed << std::setprecision(precision) << 1.5;
+            TEST_EQ(ss2.str(), expected);
+            std::replace(expected.begin(), expected.end(), '.', ',');
+        }
+    }
+    // Date formats are cached by pattern, use more patterns than fit into the cache
+    ss2 << as::gmt;
+    for(int i = 0; i < 100; ++i) {
+        const std::string suffix = " " + std::to_string(i);
+        ss2.str("");
+        ss2 << as::ftime("%Y-%m-%d" + suffix) << time_t(86400);
+        TEST_EQ(ss2.str(), "1970-01-02" + suffix);
+    }
+}
+
 template<typename CharType, typename T>
 void test_format_class_impl(const std::string& fmt_string,
                             const T& value,
@@ -703,6 +1018,92 @@ void test_format_class(std::string charset = "UTF-8")
         // Restore
         std::locale::global(old_locale);
     }
+    // Reusable templates
+    {
+        using template_type = boost::locale::basic_format_template<CharType>;
+        const template_type tmpl(ascii_to<CharType>("{3} {1} {2}{4}"));
+        TEST_EQ(tmpl.render(loc, 1, 2, 3), ascii_to<CharType>("3 1 2"));
+        TEST_EQ(tmpl.render(loc, 4, "5", 6.5), ascii_to<CharType>("6.5 4 5"));
+        TEST_EQ(tmpl.render(loc), ascii_to<CharType>("  "));
+
+        const template_type num_tmpl(ascii_to<CharType>("[{1,num}] {2,w=3,>}"));
+        TEST_EQ(num_tmpl.render(loc, 1234, 5), ascii_to<CharType>("[1,234]   5"));
+        std::basic_ostringstream<CharType> ss;
+        ss.imbue(loc);
+        ss << std::setw(4) << std::left;
+        num_tmpl.write(ss, 1.5, 6);
+        TEST_EQ(ss.str(), ascii_to<CharType>("[   1.5]   6")); // Width applies to the first character
+        TEST_EQ(ss.width(), 0);
+        TEST(ss.flags() & std::ios_base::left); // Stream state is restored
+
+        boost::locale::generator g;
+        g.add_messages_domain("default/ISO-8859-8");
+        g.add_messages_path(message_path);
+        const std::locale loc_he = g("he_IL.UTF-8");
+        const std::locale loc_en = g("en_US.UTF-8");
+        const template_type translated(boost::locale::translate(ascii_to<CharType>("hello")));
+        const string_type hello_he = to_correct_string<CharType>("שלום", loc_he);
+        for(int i = 0; i < 2; i++) {
+            TEST_EQ(translated.render(loc_he), hello_he);
+            TEST_EQ(translated.render(loc_en), ascii_to<CharType>("hello"));
+        }
+        // Only the most recently used locales are cached, others are translated again
+        {
+            std::vector<std::locale> generated;
+            for(size_t i = 0; i < boost::locale::detail::locale_cache::max_size * 2; i++)
+                generated.push_back(g(i % 2 ? "he_IL.UTF-8" : "en_US.UTF-8"));
+            for(int j = 0; j < 2; j++) {
+                for(size_t i = 0; i < generated.size(); i++)
+                    TEST_EQ(translated.render(generated[i]), i % 2 ? hello_he : ascii_to<CharType>("hello"));
+            }
+        }
+
+        // Translations with placeholders are parsed when loading the catalog and shared by all users
+        {
+            boost::locale::generator g_fmt;
+            g_fmt.add_messages_domain("format");
+            g_fmt.add_messages_path(message_path);
+            const std::locale loc_fmt = g_fmt("he_IL.UTF-8");
+            const auto msg = boost::locale::translate(ascii_to<CharType>("{1} apples"));
+            string_type buffer;
+            const auto* catalog_format = msg.translate_format(loc_fmt, 0, buffer);
+            TEST(catalog_format);
+            TEST(buffer.empty());
+            TEST(msg.translate_format(loc_fmt, 0, buffer) == catalog_format);
+            TEST(!msg.translate_format(loc_en, 0, buffer)); // Not translated
+            TEST_EQ(buffer, ascii_to<CharType>("{1} apples"));
+            // Without placeholders the translation is written directly
+            TEST(!boost::locale::translate(ascii_to<CharType>("no placeholders")).translate_format(loc_fmt, 0, buffer));
+            TEST_EQ(buffer, to_correct_string<CharType>("ללא", loc_fmt));
+
+            const template_type apples(boost::locale::translate(ascii_to<CharType>("{1} apples")));
+            TEST_EQ(apples.render(loc_fmt, 3), to_correct_string<CharType>("3 תפוחים", loc_fmt));
+            const auto files =
+              boost::locale::translate(ascii_to<CharType>("{1} file"), ascii_to<CharType>("{1} files"), 1);
+            TEST_EQ(template_type(files).render(loc_fmt, 1), to_correct_string<CharType>("קובץ 1", loc_fmt));
+            const auto more_files =
+              boost::locale::translate(ascii_to<CharType>("{1} file"), ascii_to<CharType>("{1} files"), 2);
+            TEST_EQ(template_type(more_files).render(loc_fmt, 2), to_correct_string<CharType>("2 קבצים", loc_fmt));
+        }
+
+        // Render into many locales at once
+        const std::vector<std::locale> locales{loc_he, loc_en, loc, loc_he};
+        const auto rendered = translated.render_all(locales);
+        TEST_EQ(rendered.size(), locales.size());
+        TEST_EQ(rendered.str(0), hello_he);
+        TEST_EQ(rendered.str(1), ascii_to<CharType>("hello"));
+        TEST_EQ(rendered.str(3), hello_he);
+        TEST_EQ(rendered.buffer(), hello_he + ascii_to<CharType>("hellohello") + hello_he);
+        TEST_EQ(rendered.offsets().back(), rendered.buffer().size());
+
+        const template_type cur_tmpl(ascii_to<CharType>("{2}: {1,cur}"));
+        const auto amounts = cur_tmpl.render_all(locales.begin() + 1, locales.end() - 1, 1234, "total");
+        TEST_EQ(amounts.size(), 2u);
+        TEST_EQ(string_type(amounts[0].begin(), amounts[0].end()), ascii_to<CharType>("total: $1,234.00"));
+        TEST_EQ(amounts.str(1), amounts.str(0));
+        TEST_EQ(cur_tmpl.render_all(locales.end(), locales.end(), 1).size(), 0u);
+    }
+
     // Allows many params
     TEST_EQ(do_format<CharType>(loc, "{1}{2}{3}{4}{5}{10}{9}{8}{7}{6}", 11, 22, 33, 44, 55, 'a', 'b', 'c', 'd', 'f'),
             ascii_to<CharType>("1122334455fdcba"));
@@ -853,9 +1254,18 @@ void test_main(int argc, char** argv)
     std::cout << "Testing char, UTF-8" << std::endl;
     test_manip<char>();
     test_format_class<char>();
-    std::cout << "Testing char, ISO8859-1" << std::endl;
-    test_manip<char>("ISO8859-1");
-    test_format_class<char>("ISO8859-1");
+    BOOST_LOCALE_START_CONST_CONDITION
+    if(has_legacy_encodings) {
+        BOOST_LOCALE_END_CONST_CONDITION
+        std::cout << "Testing char, ISO8859-1" << std::endl;
+        test_manip<char>("ISO8859-1");
+        test_format_class<char>("ISO8859-1");
+    }
+    test_stream_formatter_reuse();
+    test_integral_numbers();
+    test_fractional_numbers();
+    test_parse_numbers();
+    test_format_values();
 
     std::cout << "Testing wchar_t" << std::endl;
     test_manip<wchar_t>();
@@ -52,6 +52,16 @@ struct test_facet : public std::locale::facet {
 
 std::locale::id test_facet::id;
 
+struct counted_facet : public std::locale::facet {
+    counted_facet() : std::locale::facet(0) { ++instances; }
+    ~counted_facet() { --instances; }
+    static std::locale::id id;
+    static int instances;
+};
+
+std::locale::id counted_facet::id;
+int counted_facet::instances = 0;
+
 template<typename CharType>
 using codecvt_by_char_type = std::codecvt<CharType, char, std::mbstate_t>;
 
@@ -229,9 +239,105 @@ void test_install_chartype(const std::string& backendName)
                 TEST(origLocale == newLocale_char);
             TEST(origLocale == newLocale_nochar);
         }
+        // Installing multiple categories at once provides the facets of all of them
+        const std::locale classic = std::locale::classic();
+        const std::locale numLocale =
+          backend->install_all(classic, bl::category_t::formatting | bl::category_t::parsing, bl::char_facet_t::char_f);
+        TEST(&std::use_facet<std::num_put<char>>(numLocale) != &std::use_facet<std::num_put<char>>(classic));
+        TEST(&std::use_facet<std::num_get<char>>(numLocale) != &std::use_facet<std::num_get<char>>(classic));
+        TEST(&std::use_facet<std::num_get<wchar_t>>(numLocale) == &std::use_facet<std::num_get<wchar_t>>(classic));
+    }
+}
+
+void test_c_locale_facets()
+{
+    for(const std::string& backendName : bl::localization_backend_manager::global().get_all_backends()) {
+        std::cout << "C locale facets of backend: " << backendName << std::endl;
+        bl::localization_backend_manager mgr = bl::localization_backend_manager::global();
+        mgr.select(backendName);
+        bl::generator g(mgr);
+        for(const std::string localeName : {"C", "C.UTF-8", "POSIX", "en_US_POSIX.UTF-8"}) {
+            const std::locale l = g(localeName);
+            // Code point order for the quaternary and identical levels
+            const auto& col = std::use_facet<bl::collator<char>>(l);
+            TEST_LT(col.compare(bl::collate_level::quaternary, "B", "a"), 0);
+            TEST_LT(col.compare(bl::collate_level::identical, "B", "a"), 0);
+            TEST_EQ(col.compare(bl::collate_level::identical, "abc", "abc"), 0);
+            TEST_GT(col.compare(bl::collate_level::identical, "abcd", "abc"), 0);
+            TEST_LT(col.transform(bl::collate_level::identical, "B"), col.transform(bl::collate_level::identical, "a"));
+            TEST_EQ(col.hash(bl::collate_level::identical, "abc"), col.hash(bl::collate_level::identical, "abc"));
+            TEST(l(std::wstring(L"Z"), std::wstring(L"a")));
+            if(localeName == "C.UTF-8")
+                TEST_LT(col.compare(bl::collate_level::identical, "z", "\xC3\xA4"), 0); // z < a-umlaut
+            // ICU uses its collation for the other levels, the other backends the code point order.
+            // ICU's en_US_POSIX collation orders ASCII by code points too
+            if(backendName == "icu" && localeName != "en_US_POSIX.UTF-8") {
+                TEST_GT(col.compare(bl::collate_level::primary, "B", "a"), 0);
+                TEST_EQ(col.compare(bl::collate_level::primary, "abc", "ABC"), 0);
+                TEST_LT(col.compare(bl::collate_level::tertiary, "abc", "ABC"), 0);
+            } else {
+                TEST_LT(col.compare(bl::collate_level::primary, "B", "a"), 0);
+                TEST_GT(col.compare(bl::collate_level::primary, "abc", "ABC"), 0);
+            }
+
+            TEST_EQ(bl::to_upper("Hello World 1", l), "HELLO WORLD 1");
+            TEST_EQ(bl::to_lower(L"Hello World 1", l), L"hello world 1");
+            TEST_EQ(bl::fold_case("Hello", l), "hello");
+            TEST_EQ(bl::normalize("Hello", bl::norm_nfd, l), "Hello");
+        }
     }
 }
 
+void test_default_locale()
+{
+    bl::generator g;
+    const std::locale l1 = g("en_US.UTF-8");
+    const std::locale l2 = g("de_DE.UTF-8");
+    const std::locale orig = std::locale();
+    TEST(bl::default_locale() == std::locale());
+    // Changes via std::locale::global are seen until the global locale is set by Boost.Locale
+    std::locale::global(l1);
+    TEST(bl::default_locale() == l1);
+    TEST(bl::default_locale(l2) == l1);
+    TEST(std::locale() == l2);
+    TEST(bl::default_locale() == l2);
+    TEST_EQ(std::use_facet<bl::info>(bl::default_locale()).language(), "de");
+    TEST_EQ(bl::to_upper("abc"), "ABC");
+    // The same per-thread locale is returned until the global locale changes
+    TEST(&bl::default_locale() == &bl::default_locale());
+    TEST(bl::default_locale(orig) == l2);
+    TEST(bl::default_locale() == orig);
+    // Changes via std::locale::global are seen again after untracking
+    bl::untrack_default_locale();
+    std::locale::global(l1);
+    TEST(bl::default_locale() == l1);
+    std::locale::global(orig);
+    TEST(bl::default_locale() == orig);
+}
+
+void test_lazy_facets()
+{
+#ifdef BOOST_LOCALE_WITH_ICU
+    bl::localization_backend_manager mgr = bl::localization_backend_manager::global();
+    mgr.select("icu");
+    bl::generator g(mgr);
+    TEST(!g.lazy_facets());
+    g.lazy_facets(true);
+    TEST(g.lazy_facets());
+    const std::locale l = g("en_US.UTF-8");
+    TEST(blt::has_facet<bl::converter<char>>(l));
+    TEST(blt::has_facet<bl::collator<wchar_t>>(l));
+    TEST(has_message(l));
+    // Facets are created on first use and behave as the eagerly created ones
+    TEST_EQ(bl::to_upper("grüßen", l), "GRÜSSEN");
+    TEST_EQ(bl::to_upper(L"abc", l), L"ABC");
+    TEST(std::use_facet<bl::collator<char>>(l).compare(bl::collate_level::primary, "a", "A") == 0);
+    TEST(std::use_facet<bl::collator<char>>(l).compare(bl::collate_level::tertiary, "a", "b") < 0);
+    TEST(l(std::wstring(L"a"), std::wstring(L"b")));
+    TEST_EQ(bl::translate("hello").str(l), "hello");
+#endif
+}
+
 void test_main(int /*argc*/, char** /*argv*/)
 {
     {
@@ -253,6 +359,14 @@ void test_main(int /*argc*/, char** /*argv*/)
         std::vector<std::string> all_backends = bl::localization_backend_manager::global().get_all_backends();
         std::sort(all_backends.begin(), all_backends.end());
         TEST_EQ(all_backends, backends);
+
+        // Copies share their state until modified
+        bl::localization_backend_manager copy = bl::localization_backend_manager::global();
+        copy.remove_all_backends();
+        TEST(copy.get_all_backends().empty());
+        all_backends = bl::localization_backend_manager::global().get_all_backends();
+        std::sort(all_backends.begin(), all_backends.end());
+        TEST_EQ(all_backends, backends);
     }
 
     const bl::localization_backend_manager orig_backend = bl::localization_backend_manager::global();
@@ -262,7 +376,16 @@ void test_main(int /*argc*/, char** /*argv*/)
         tmp_backend.select(backendName);
         bl::localization_backend_manager::global(tmp_backend);
         bl::generator g;
-        for(const std::string localeName : {"", "C", "en_US.UTF-8", "en_US.ISO8859-1", "tr_TR.windows1254"}) {
+        for(const std::string localeName : {
+              "",
+              "C",
+              "en_US.UTF-8",
+#ifndef BOOST_LOCALE_UTF8_ONLY
+              "en_US.ISO8859-1",
+              "tr_TR.windows1254",
+#endif
+            })
+        {
             std::cout << "-- Locale: " << localeName << std::endl;
             const std::locale l = g(localeName);
 #ifdef BOOST_LOCALE_ENABLE_CHAR16_T
@@ -325,11 +448,13 @@ void test_main(int /*argc*/, char** /*argv*/)
         l = g("en_US.UTF-8");
         TEST(has_message(l));
 
+#ifndef BOOST_LOCALE_UTF8_ONLY
         l = g("en_US.ISO8859-1");
         TEST_EQ(std::use_facet<bl::info>(l).language(), "en");
         TEST_EQ(std::use_facet<bl::info>(l).country(), "US");
         TEST(!std::use_facet<bl::info>(l).utf8());
         TEST_EQ(std::use_facet<bl::info>(l).encoding(), "ISO8859-1");
+#endif
 
         l = g("en_US.UTF-8");
         TEST_EQ(std::use_facet<bl::info>(l).language(), "en");
@@ -337,34 +462,93 @@ void test_main(int /*argc*/, char** /*argv*/)
         TEST(std::use_facet<bl::info>(l).utf8());
         TEST_EQ(std::use_facet<bl::info>(l).encoding(), "UTF-8");
 
+#ifndef BOOST_LOCALE_UTF8_ONLY
         l = g("en_US.ISO8859-1");
         TEST_EQ(std::use_facet<bl::info>(l).language(), "en");
         TEST_EQ(std::use_facet<bl::info>(l).country(), "US");
         TEST(!std::use_facet<bl::info>(l).utf8());
         TEST_EQ(std::use_facet<bl::info>(l).encoding(), "ISO8859-1");
+#endif
 
         // Check that generate() extends the given locale, not replaces it
         std::locale l_wt(std::locale::classic(), new test_facet);
         TEST(blt::has_facet<test_facet>(g.generate(l_wt, "en_US.UTF-8")));
         TEST(!blt::has_facet<test_facet>(g.generate("en_US.UTF-8")));
+#ifndef BOOST_LOCALE_UTF8_ONLY
         TEST(blt::has_facet<test_facet>(g.generate(l_wt, "en_US.ISO8859-1")));
         TEST(!blt::has_facet<test_facet>(g.generate("en_US.ISO8859-1")));
+#endif
 
         // Check caching works
         g.locale_cache_enabled(true);
         // Generate a locale with a specific facet which is then cached
         g.generate(l_wt, "en_US.UTF-8");
-        g.generate(l_wt, "en_US.ISO8859-1");
+        g.generate(l_wt, "de_DE.UTF-8");
         // Cached locale is returned -> facet is still there
         TEST(blt::has_facet<test_facet>(g("en_US.UTF-8")));
-        TEST(blt::has_facet<test_facet>(g("en_US.ISO8859-1")));
+        TEST(blt::has_facet<test_facet>(g("de_DE.UTF-8")));
         // Check a property to verify it doesn't simply return the same locale for each call
-        TEST(std::use_facet<bl::info>(g("en_US.UTF-8")).utf8());
-        TEST(!std::use_facet<bl::info>(g("en_US.ISO8859-1")).utf8());
+        TEST_EQ(std::use_facet<bl::info>(g("en_US.UTF-8")).language(), "en");
+        TEST_EQ(std::use_facet<bl::info>(g("de_DE.UTF-8")).language(), "de");
+
+        // Limit the cache size, evicting the least recently used locales
+        {
+            bl::generator g_lim;
+            g_lim.categories(bl::category_t::information);
+            g_lim.locale_cache_enabled(true);
+            TEST_EQ(g_lim.locale_cache_limit(), 0u);
+            g_lim.locale_cache_limit(2);
+            TEST_EQ(g_lim.locale_cache_limit(), 2u);
+            g_lim("en_US.UTF-8");
+            g_lim("de_DE.UTF-8");
+            g_lim("en_US.UTF-8"); // Hit, de_DE is now the least recently used
+            g_lim("he_IL.UTF-8"); // Evicts de_DE
+            g_lim("en_US.UTF-8");
+            auto stats = g_lim.locale_cache_statistics();
+            TEST_EQ(stats.hits, 2u);
+            TEST_EQ(stats.misses, 3u);
+            TEST_EQ(stats.evictions, 1u);
+            TEST_EQ(stats.size, 2u);
+            g_lim("de_DE.UTF-8"); // Generated again, evicts he_IL
+            TEST_EQ(g_lim.locale_cache_statistics().misses, 4u);
+            g_lim("en_US.UTF-8");
+            TEST_EQ(g_lim.locale_cache_statistics().hits, 3u);
+            g_lim.locale_cache_limit(1);
+            stats = g_lim.locale_cache_statistics();
+            TEST_EQ(stats.evictions, 3u);
+            TEST_EQ(stats.size, 1u);
+            TEST_EQ(std::use_facet<bl::info>(g_lim("en_US.UTF-8")).language(), "en"); // Most recently used is kept
+            TEST_EQ(g_lim.locale_cache_statistics().hits, 4u);
+            g_lim.clear_cache();
+            TEST_EQ(g_lim.locale_cache_statistics().size, 0u);
+        }
+        // Many locales and releasing them with the generator
+        {
+            bl::generator g_many;
+            g_many.categories(bl::category_t::information);
+            g_many.locale_cache_enabled(true);
+            const std::locale base(std::locale::classic(), new counted_facet);
+            for(int i = 0; i < 100; i++)
+                g_many.generate(base, "en_US.UTF-8@v" + std::to_string(i));
+            TEST_EQ(g_many.locale_cache_statistics().size, 100u);
+            for(int i = 0; i < 100; i++) {
+                const std::locale l = g_many("en_US.UTF-8@v" + std::to_string(i));
+                TEST(blt::has_facet<counted_facet>(l));
+                TEST_EQ(std::use_facet<bl::info>(l).variant(), "v" + std::to_string(i));
+            }
+            TEST_EQ(g_many.locale_cache_statistics().hits, 100u);
+            g_many.locale_cache_limit(10);
+            TEST_EQ(g_many.locale_cache_statistics().size, 10u);
+            TEST(counted_facet::instances > 0);
+        }
+        TEST_EQ(counted_facet::instances, 0);
 
         test_install_chartype(backendName);
     }
     std::cout << "Test special locales" << std::endl;
     test_special_locales();
     test_invalid_locale();
+    test_c_locale_facets();
+    test_default_locale();
+    test_lazy_facets();
 }
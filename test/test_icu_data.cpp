@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/locale/formatting.hpp>
+#include <boost/locale/generator.hpp>
+#include <boost/locale/info.hpp>
+#include <boost/locale/localization_backend.hpp>
+#include <iostream>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "boostLocale/test/tools.hpp"
+#include "boostLocale/test/unit_test.hpp"
+
+namespace bl = boost::locale;
+
+// Requires the library to be built with data containing (at least) the English locales,
+// e.g. created by tools/trim_icu_data.cmake with LANGUAGES=en
+BOOST_LOCALE_DISABLE_UNREACHABLE_CODE_WARNING
+void test_main(int /*argc*/, char** /*argv*/)
+{
+#if !defined(BOOST_LOCALE_WITH_ICU) || !defined(BOOST_LOCALE_ICU_EMBEDDED_DATA)
+    std::cout << "ICU data is not embedded... Skipping\n";
+    return;
+#endif
+    bl::localization_backend_manager mgr = bl::localization_backend_manager::global();
+    mgr.select("icu");
+    bl::generator g(mgr);
+
+    std::cout << "Locale with data" << std::endl;
+    {
+        const std::locale l = g("en_US.UTF-8");
+        TEST_EQ(std::use_facet<bl::info>(l).language(), "en");
+        std::ostringstream ss;
+        ss.imbue(l);
+        ss << bl::as::number << 1234.5;
+        TEST_EQ(ss.str(), "1,234.5");
+    }
+
+    std::cout << "C locale" << std::endl;
+    {
+        const std::locale l = g("C.UTF-8");
+        std::ostringstream ss;
+        ss.imbue(l);
+        ss << bl::as::number << 1234.5;
+        TEST_EQ(ss.str(), "1234.5");
+    }
+
+    std::cout << "Locale without data" << std::endl;
+    // Not part of any ICU data, only the root locale would be found
+    TEST_THROWS(g("xx_XX.UTF-8"), std::runtime_error);
+    // Dropped by the trimming
+    TEST_THROWS(g("de_DE.UTF-8"), std::runtime_error);
+    TEST_THROWS(g("he_IL.UTF-8"), std::runtime_error);
+}
@@ -586,6 +586,23 @@ void test_main(int argc, char** argv)
             TEST_EQ(bl::gettext(bl::conv::from_utf("לא קיים", "ISO-8859-8").c_str(), l), "לא קיים");
         }
     }
+#ifdef BOOST_LOCALE_WITH_ICU
+    std::cout << "Testing errors of lazily loaded catalogs" << std::endl;
+    {
+        bl::localization_backend_manager mgr = bl::localization_backend_manager::global();
+        mgr.select("icu");
+        bl::generator g(mgr);
+        g.add_messages_domain("invalid");
+        g.add_messages_path(message_path);
+        // By default errors in catalogs are reported when generating the locale
+        TEST_THROWS(g("he_IL.UTF-8"), std::runtime_error);
+        g.lazy_facets(true);
+        const std::locale l = g("he_IL.UTF-8");
+        // Otherwise on each use of the catalog
+        TEST_THROWS(bl::translate("hello").str(l), std::runtime_error);
+        TEST_THROWS(bl::translate("hello").str(l), std::runtime_error);
+    }
+#endif
     // Test compiles
     {
         bl::gettext("");
@@ -147,6 +147,15 @@ void test_by_char(const std::locale& l, const std::locale& lreal)
             TEST_EQ(to_utf8(ss.str()), "16");
             empty_stream(ss) << as::time_zone("GMT+00:15") << as::ftime(ascii_to<CharType>("%M")) << a_datetime;
             TEST_EQ(to_utf8(ss.str()), "48");
+            // The last output is cached, changes of any parameter must be honored
+            empty_stream(ss) << a_datetime << ' ' << a_datetime << ' ' << (a_datetime + 60);
+            TEST_EQ(to_utf8(ss.str()), "48 48 49");
+            empty_stream(ss) << as::time_zone("GMT") << a_datetime;
+            TEST_EQ(to_utf8(ss.str()), "33");
+            empty_stream(ss) << as::ftime(ascii_to<CharType>("%H")) << a_datetime;
+            TEST_EQ(to_utf8(ss.str()), "15");
+            empty_stream(ss) << std::setw(4) << std::left << a_datetime << '|';
+            TEST_EQ(to_utf8(ss.str()), "15  |");
         }
     }
 }
@@ -211,6 +211,8 @@ void test_main(int /*argc*/, char** /*argv*/)
             test_sjis = true;
             test_utf = true;
         }
+        if(!has_legacy_encodings)
+            test_iso = test_sjis = false;
 
         test_wide_io();
     }
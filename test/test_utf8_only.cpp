@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2023 Alexander Grund
+//
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/locale/conversion.hpp>
+#include <boost/locale/encoding_errors.hpp>
+#include <boost/locale/generator.hpp>
+#include <boost/locale/info.hpp>
+#include <boost/locale/localization_backend.hpp>
+#include <iostream>
+#include <locale>
+#include <string>
+
+#include "boostLocale/test/tools.hpp"
+#include "boostLocale/test/unit_test.hpp"
+
+namespace bl = boost::locale;
+
+BOOST_LOCALE_DISABLE_UNREACHABLE_CODE_WARNING
+void test_main(int /*argc*/, char** /*argv*/)
+{
+#ifndef BOOST_LOCALE_UTF8_ONLY
+    std::cout << "Not built with BOOST_LOCALE_UTF8_ONLY... Skipping\n";
+    return;
+#endif
+    for(const std::string& backendName : bl::localization_backend_manager::global().get_all_backends()) {
+        std::cout << "Backend: " << backendName << std::endl;
+        bl::localization_backend_manager mgr = bl::localization_backend_manager::global();
+        mgr.select(backendName);
+        bl::generator g(mgr);
+
+        const std::locale utf8 = g("en_US.UTF-8");
+        TEST(std::use_facet<bl::info>(utf8).utf8());
+        TEST_EQ(bl::to_upper("hello", utf8), "HELLO");
+
+        // US-ASCII is a subset of UTF-8 and handled as such
+        for(const std::string localeName : {"C", "en_US", "en_US.US-ASCII"}) {
+            const std::locale l = g(localeName);
+            const bl::info& inf = std::use_facet<bl::info>(l);
+            TEST(inf.utf8());
+            TEST_EQ(inf.encoding(), "UTF-8");
+            TEST_EQ(bl::to_upper("hello", l), "HELLO");
+        }
+
+        // The WinAPI backend uses the C locale for other encodings, the others reject them
+        if(backendName != "winapi")
+            TEST_THROWS(g("en_US.ISO8859-1"), bl::conv::invalid_charset_error);
+    }
+}
@@ -0,0 +1,22 @@
+# Copyright (c) 2023 Alexander Grund
+# Distributed under the Boost Software License, Version 1.0.
+# https://www.boost.org/LICENSE_1_0.txt
+
+# Generate a C++ source file containing an ICU data file (.dat) as an array.
+# Usage: cmake -DINPUT=<icudt*.dat> -DOUTPUT=<source.cpp> -P embed_icu_data.cmake
+
+cmake_minimum_required(VERSION 3.5)
+
+if(NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "INPUT and OUTPUT must be set")
+endif()
+
+file(READ "${INPUT}" data HEX)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," data "${data}")
+# ICU requires the data to be 16 byte aligned
+file(WRITE "${OUTPUT}"
+    "// Generated from ${INPUT}\n"
+    "namespace boost { namespace locale { namespace impl_icu {\n"
+    "    alignas(16) extern const unsigned char embedded_icu_data[] = {${data}};\n"
+    "}}}\n"
+)
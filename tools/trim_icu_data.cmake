@@ -0,0 +1,51 @@
+# Copyright (c) 2023 Alexander Grund
+# Distributed under the Boost Software License, Version 1.0.
+# https://www.boost.org/LICENSE_1_0.txt
+
+# Create an ICU data file (.dat) containing only the locale data for the given languages,
+# e.g. to be used for BOOST_LOCALE_ICU_DATA.
+# All other data (converters, break iterators, time zones, ...) is kept.
+# The output must have the same file name as the input as that is the name of the ICU data package.
+# Usage: cmake -DINPUT=<icudt*.dat> -DOUTPUT=<trimmed.dat> -DLANGUAGES=en;de [-DICUPKG=<path>] -P trim_icu_data.cmake
+
+cmake_minimum_required(VERSION 3.5)
+
+if(NOT INPUT OR NOT OUTPUT OR NOT LANGUAGES)
+    message(FATAL_ERROR "INPUT, OUTPUT and LANGUAGES must be set")
+endif()
+get_filename_component(input_name "${INPUT}" NAME)
+get_filename_component(output_name "${OUTPUT}" NAME)
+if(NOT input_name STREQUAL output_name)
+    message(FATAL_ERROR "The output file must be named ${input_name}")
+endif()
+if(NOT ICUPKG)
+    find_program(ICUPKG icupkg PATHS "$ENV{ICU_ROOT}/sbin" /usr/sbin)
+    if(NOT ICUPKG)
+        message(FATAL_ERROR "icupkg not found, set ICUPKG")
+    endif()
+endif()
+
+execute_process(COMMAND "${ICUPKG}" -l "${INPUT}" OUTPUT_VARIABLE items RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to list the contents of ${INPUT}")
+endif()
+string(REPLACE "\n" ";" items "${items}")
+
+string(REPLACE ";" "|" languages "${LANGUAGES}")
+set(removed "")
+foreach(item IN LISTS items)
+    # Locale data is in files named by the locale, in the top level and in the per-service trees (coll/, curr/, ...)
+    if(item MATCHES "^([a-z]+/)?[a-z][a-z][a-z]?(_[A-Za-z0-9_]*)?\\.res$"
+       AND NOT item MATCHES "^([a-z]+/)?res_index\\.res$"
+       AND NOT item MATCHES "^([a-z]+/)?(${languages})(_[A-Za-z0-9_]*)?\\.res$")
+        string(APPEND removed "${item}\n")
+    endif()
+endforeach()
+
+set(remove_list "${OUTPUT}.remove.txt")
+file(WRITE "${remove_list}" "${removed}")
+execute_process(COMMAND "${ICUPKG}" -r "${remove_list}" "${INPUT}" "${OUTPUT}" RESULT_VARIABLE result)
+file(REMOVE "${remove_list}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to create ${OUTPUT}")
+endif()